@@ -113,6 +113,52 @@ try {
   print(`Level set test skipped: ${e}`);
 }
 
+// Test 9b: Level set from a native sdf expression
+const sdfSphere = levelSet({
+  sdf: sdf.sphere(5),
+  bounds: {min: [-6, -6, -6], max: [6, 6, 6]},
+  edgeLength: 0.5
+});
+const sphereVolume = (4 / 3) * Math.PI * 125;
+assert(Math.abs(volume(sdfSphere) - sphereVolume) / sphereVolume < 0.05,
+       "Native sdf sphere should have the volume of a sphere");
+const infill = levelSet({
+  sdf: sdf.intersection(sdf.gyroid(5, 0.8), sdf.box(20)),
+  bounds: {min: [-11, -11, -11], max: [11, 11, 11]},
+  edgeLength: 0.5
+});
+assert(!isEmpty(infill), "Gyroid infill should not be empty");
+assert(volume(infill) < 8000, "Gyroid infill should be sparser than its box");
+const blended = sdf.smoothUnion(sdf.sphere(3), sdf.translate(sdf.box([4, 4, 4]), [4, 0, 0]), 1);
+assert(!isEmpty(levelSet({sdf: blended, bounds: {min: [-4, -4, -4], max: [7, 4, 4]}, edgeLength: 0.5})),
+       "Smooth union should not be empty");
+
+const turnedBox = levelSet({sdf: sdf.rotate(sdf.box([4, 8, 2]), [0, 0, 90]),
+                           bounds: {min: [-5, -5, -5], max: [5, 5, 5]}, edgeLength: 0.5});
+const plainBox = levelSet({sdf: sdf.box([8, 4, 2]),
+                           bounds: {min: [-5, -5, -5], max: [5, 5, 5]}, edgeLength: 0.5});
+assert(Math.abs(volume(turnedBox) - volume(plainBox)) < 1e-6 * volume(plainBox),
+       "sdf.rotate by 90 degrees should match the axis-swapped box");
+assert(sdf.sphere.length === 1 && sdf.smoothUnion.length === 3,
+       "sdf functions should report their own arity");
+
+// Test 9c: Level set from a batched JS callback
+let batchCalls = 0;
+const batchSphere = levelSet({
+  sdfBatch: (points, out) => {
+    batchCalls++;
+    for (let i = 0; i < out.length; i++) {
+      const x = points[3 * i], y = points[3 * i + 1], z = points[3 * i + 2];
+      out[i] = 5 - Math.sqrt(x * x + y * y + z * z);
+    }
+  },
+  bounds: {min: [-6, -6, -6], max: [6, 6, 6]},
+  edgeLength: 0.5
+});
+assert(Math.abs(volume(batchSphere) - sphereVolume) / sphereVolume < 0.05,
+       "Batched sdf sphere should have the volume of a sphere");
+assert(batchCalls < 10, `sdfBatch should be called once per block (got ${batchCalls} calls)`);
+
 // Test 10: Property calculations
 const withProps = calculateNormals(complex, 0);
 assert(numProperties(withProps) > 3, "Should have more than 3 properties after normals");
@@ -47,6 +47,19 @@ for (let i = 0; i < 5; i++) {
 }
 timeOperation("Multiple differences", () => complex);
 
+// Test 5b: Querying a difference chain every step must stay linear: each
+// step batches only the new hole onto the previous result
+timeOperation("Queried differences (200 holes)", () => {
+  let drilled = cube({size: [100, 100, 2], center: false});
+  for (let i = 0; i < 200; i++) {
+    const hole = translate(cylinder({height: 4, radius: 1}),
+                           [3 + (i % 20) * 4.8, 3 + Math.floor(i / 20) * 9.5, -1]);
+    drilled = difference(drilled, hole);
+    volume(drilled);
+  }
+  return drilled;
+});
+
 // Test 6: Mesh operations
 const sphere2 = sphere({radius: 5});
 timeOperation("Refine", () => refine(sphere2, 1));
@@ -60,6 +73,15 @@ for (let i = 0; i < 20; i++) {
 }
 timeOperation("Batch boolean (20 objects)", () => batchBoolean("add", manyCubes));
 
+// Test 7b: Variadic calls with many inputs. The repeat is served from the
+// geometry cache, so it measures only the binding's per-input overhead.
+const manyParts = [];
+for (let i = 0; i < 500; i++) {
+  manyParts.push(translate(cube({size: [1, 1, 1], center: false}), [i % 25, Math.floor(i / 25), 0]));
+}
+timeOperation("Compose (500 objects)", () => compose(manyParts));
+timeOperation("Compose (500 objects, cached)", () => compose(manyParts));
+
 // Test 8: Hull operations
 const points = [];
 for (let i = 0; i < 10; i++) {
@@ -0,0 +1,29 @@
+// Placement scene test - repeated parts exported as {manifold, transform}
+// placements instead of a union, so the viewer draws them as instances
+
+const post = union(
+  cube({size: [4, 4, 2], center: true}),
+  translate(cylinder({height: 12, radius: 1.5}), [0, 0, 1])
+);
+
+const placements = [];
+for (let i = 0; i < 4; i++) {
+  const angle = (i * Math.PI) / 2;
+  const c = Math.cos(angle);
+  const s = Math.sin(angle);
+  placements.push({
+    manifold: post,
+    transform: [
+      c, -s, 0, 10 * c,
+      s, c, 0, 10 * s,
+      0, 0, 1, 0
+    ]
+  });
+}
+placements.push({manifold: cube({size: [24, 24, 1], center: true})});
+
+// Verify the placed part
+assert(!isEmpty(post), "Placed part should not be empty");
+assert(volume(post) > 0, "Placed part should have positive volume");
+
+scene = placements;
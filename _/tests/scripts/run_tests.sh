@@ -100,9 +100,13 @@ with open('$JSON_RESULTS', 'w') as f:
 PYTHON_SCRIPT
 }
 
-# Helper function to run a test
+# Helper function to run a test; any arguments after the file replace the
+# default viewer command line
 run_test() {
     local test_file="$1"
+    shift
+    local runner=("$@")
+    [[ ${#runner[@]} -gt 0 ]] || runner=("$VIEWER_BIN")
     local test_name=$(basename "$test_file" .js)
     local test_dir=$(dirname "$test_file")
     local test_type=$(basename "$test_dir")
@@ -147,7 +151,7 @@ EOF
     local test_status="skipped"
     
     # Run test (non-interactive mode - just check if it loads)
-    if timeout 30 "$VIEWER_BIN" "$temp_scene" > "$output_file" 2>&1; then
+    if timeout 30 "${runner[@]}" "$temp_scene" > "$output_file" 2>&1; then
         echo -e "${GREEN}✓ PASSED${NC}"
         ((PASSED++))
         test_status="passed"
@@ -181,6 +185,17 @@ for test_file in "$TEST_DIR/unit"/*.js; do
     run_test "$test_file"
 done
 
+# Evaluate the mesh tests at preview and then full quality with the CLI, so
+# results cached at one quality are checked against the other
+CLI_BIN="$BUILD_DIR/viewer/dingcad_cli"
+if [[ -x "$CLI_BIN" ]]; then
+    for quality in preview full; do
+        run_test "$TEST_DIR/unit/test_mesh_operations.js" \
+            "$CLI_BIN" -q "$quality" -o "/tmp/dingcad_test_$$.stl"
+    done
+    rm -f "/tmp/dingcad_test_$$.stl"
+fi
+
 # Run integration tests
 echo ""
 echo "=== Running Integration Tests ==="
@@ -25,6 +25,22 @@ const revolved = revolve([halfCircle], {segments: 32, degrees: 360});
 assert(!isEmpty(revolved), "Revolved object should not be empty");
 assert(volume(revolved) > 0, "Revolved object should have positive volume");
 
+// Test extrude/revolve with flat typed-array polygons
+const flatSquare = new Float64Array([0, 0, 10, 0, 10, 10, 0, 10]);
+const extrudedFlat = extrude(flatSquare, {height: 5});
+assert(Math.abs(volume(extrudedFlat) - volume(extruded)) < 1e-6,
+       "Flat square should extrude like the nested one");
+const withHole = {
+  points: new Float32Array([0, 0, 10, 0, 10, 10, 0, 10, 3, 3, 3, 7, 7, 7, 7, 3]),
+  loopOffsets: new Uint32Array([0, 4])
+};
+const extrudedHole = extrude(withHole, {height: 5});
+assert(Math.abs(volume(extrudedHole) - (100 - 16) * 5) < 1e-3,
+       "loopOffsets should split flat points into outer loop and hole");
+const flatHalfCircle = new Float64Array(halfCircle.flat());
+assert(Math.abs(volume(revolve(flatHalfCircle, {segments: 32})) - volume(revolved)) < 1e-6,
+       "Flat polygons should revolve like nested ones");
+
 // Test hull
 const cube1 = cube({size: [5, 5, 5], center: false});
 const cube2 = translate(cube1, [10, 0, 0]);
@@ -43,6 +59,8 @@ const points = [
 const hull2 = hullPoints(points);
 assert(!isEmpty(hull2), "Hull from points should not be empty");
 assert(numVertices(hull2) > 0, "Hull from points should have vertices");
+const hull3 = hullPoints(new Float64Array(points.flat()));
+assert(Math.abs(volume(hull3) - volume(hull2)) < 1e-6, "Flat Float64Array hull should match");
 
 // Test slice
 const cylinder = cylinder({height: 10, radius: 5});
@@ -55,6 +73,24 @@ const projected = project(cylinder);
 assert(Array.isArray(projected), "Project should return array of polygons");
 assert(projected.length > 0, "Project should return at least one polygon");
 
+// Test typed-array slice/project results
+const flatSlice = sliceFlat(cylinder, 5);
+assert(flatSlice.points instanceof Float64Array, "sliceFlat points should be a Float64Array");
+assert(flatSlice.loopOffsets instanceof Uint32Array, "sliceFlat loopOffsets should be a Uint32Array");
+assert(flatSlice.loopOffsets.length === sliceResult.length, "sliceFlat should keep every loop");
+assert(flatSlice.points.length === 2 * sliceResult.reduce((n, loop) => n + loop.length, 0),
+       "sliceFlat should hold every point");
+assert(!isEmpty(extrude(flatSlice, {height: 1})), "sliceFlat output should extrude directly");
+assert(projectFlat(cylinder).loopOffsets.length === projected.length,
+       "projectFlat should keep every loop");
+
+// Test meshData
+const data = meshData(cylinder);
+assert(data.vertProperties instanceof Float32Array, "vertProperties should be a Float32Array");
+assert(data.triVerts instanceof Uint32Array, "triVerts should be a Uint32Array");
+assert(data.triVerts.length === 3 * numTriangles(cylinder), "triVerts should hold every triangle");
+assert(data.vertProperties.buffer === data.triVerts.buffer, "meshData should use one buffer");
+
 // Test compose
 const part1 = cube({size: [5, 5, 5], center: false});
 const part2 = translate(cube({size: [5, 5, 5], center: false}), [5, 0, 0]);
@@ -50,6 +50,39 @@ assert(!isEmpty(multiUnion), "Multiple union should not be empty");
 assert(numTriangles(multiUnion) > numTriangles(cube1), 
        "Multiple union should have more triangles");
 
+// Test difference chains: repeated binary calls are batched on first use and
+// must match one batchBoolean over the same operands
+const plate = cube({size: [40, 40, 2], center: false});
+let drilled = plate;
+const holes = [plate];
+for (let i = 0; i < 8; i++) {
+  for (let j = 0; j < 8; j++) {
+    const hole = translate(cylinder({height: 4, radius: 1}), [4 + i * 4.5, 4 + j * 4.5, -1]);
+    drilled = difference(drilled, hole);
+    holes.push(hole);
+  }
+}
+const drilledBatch = batchBoolean("subtract", holes);
+assert(Math.abs(volume(drilled) - volume(drilledBatch)) < 1e-6,
+       "Chained differences should match batchBoolean subtract");
+assert(volume(drilled) < volume(plate), "Drilled plate should lose volume");
+// Querying the chain as it grows resolves each step once; the next link
+// starts from that result rather than rebuilding the chain from the plate
+let queried = plate;
+let lastVolume = volume(plate);
+for (let i = 0; i < 8; i++) {
+  queried = difference(queried, holes[1 + i]);
+  const v = volume(queried);
+  assert(v < lastVolume, "Each queried difference should remove volume");
+  lastVolume = v;
+}
+const queriedBatch = batchBoolean("subtract", holes.slice(0, 9));
+assert(Math.abs(volume(queried) - volume(queriedBatch)) < 1e-6,
+       "Queried difference chain should match batchBoolean subtract");
+const chainedUnion = union(union(cube1, cube2), cube3);
+assert(Math.abs(volume(chainedUnion) - volume(multiUnion)) < 1e-6,
+       "Chained unions should match a single variadic union");
+
 // Test status checking
 const status1 = status(union1);
 assert(status1 === "NoError", `Union status should be NoError, got: ${status1}`);
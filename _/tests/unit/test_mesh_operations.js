@@ -58,6 +58,8 @@ assert(numPropVerts >= numVertices(base),
 // Test asOriginal
 const original = asOriginal(base);
 assert(!isEmpty(original), "AsOriginal should not be empty");
+assert(originalId(asOriginal(base)) !== originalId(asOriginal(base)),
+       "Each asOriginal call should get its own original ID");
 
 // Test originalId
 const origId = originalId(base);
@@ -80,6 +82,45 @@ const expectedEdges = (3 * baseTriangles) / 2;
 assert(Math.abs(edges - expectedEdges) < expectedEdges * 0.5, 
        "Edge count should be approximately correct");
 
+// Test cached: the callback runs at most once per key, and the result
+// matches what it builds
+let cachedCalls = 0;
+const buildCached = () => {
+  cachedCalls++;
+  return smoothOut(sphere({radius: 4}), 60, 0.5);
+};
+const cached1 = cached("test_mesh_operations/smoothed-sphere", buildCached);
+const cached2 = cached("test_mesh_operations/smoothed-sphere", buildCached);
+assert(cachedCalls <= 1, "cached should not call the callback again for the same key");
+assert(Math.abs(volume(cached1) - volume(cached2)) < 1e-6,
+       "cached should return the same result for the same key");
+let cachedThrew = false;
+try {
+  cached("test_mesh_operations/not-a-manifold", () => 42);
+} catch (e) {
+  cachedThrew = true;
+}
+assert(cachedThrew, "cached should reject callbacks that do not return a manifold");
+
+// cached() keys are kept apart per evaluation quality. run_tests.sh runs this
+// file at preview and then at full quality against the same on-disk cache;
+// the full run must not get the coarse mesh the preview run stored.
+const qualityProbe = cached("test_mesh_operations/quality-probe", () => sphere({radius: 10}));
+assert(numTriangles(qualityProbe) === numTriangles(sphere({radius: 10})),
+       "cached should not return a result built at another quality");
+
+// A smoothOut result read back from the on-disk cache keeps its tangents, so
+// refining it gives the same smooth surface as refining a fresh one. The
+// random shift gives the refine a new key every run, so it really refines the
+// restored mesh; asOriginal keeps the fresh one out of every cache.
+const refineShift = [Math.random() * 100, 0, 0];
+const smoothStored = smoothOut(sphere({radius: 4}), 60, 0.5);
+const smoothFresh = smoothOut(asOriginal(sphere({radius: 4})), 60, 0.5);
+const refinedStored = volume(refine(translate(smoothStored, refineShift), 3));
+const refinedFresh = volume(refine(translate(smoothFresh, refineShift), 3));
+assert(Math.abs(refinedStored - refinedFresh) < 1e-4 * refinedFresh,
+       "refine of a cached smoothOut should match refine of a fresh one");
+
 scene = smoothed1; // Export for visual verification
 print("✓ All mesh operation tests passed");
 
@@ -53,11 +53,38 @@ assert(!isEmpty(transformed1), "Identity transformed object should not be empty"
 assert(Math.abs(volume(transformed1) - baseVolume) < 0.1, 
        "Identity transform should not change volume");
 
+// Test transform (row-major, last column is the translation)
+const shifted = transform(base, [
+  1, 0, 0, 5,
+  0, 1, 0, 6,
+  0, 0, 1, 7
+]);
+const baseBox = boundingBox(base);
+const shiftedBox = boundingBox(shifted);
+assert(Math.abs(shiftedBox.min[0] - baseBox.min[0] - 5) < 1e-6 &&
+       Math.abs(shiftedBox.min[1] - baseBox.min[1] - 6) < 1e-6 &&
+       Math.abs(shiftedBox.min[2] - baseBox.min[2] - 7) < 1e-6,
+       "transform should translate by the last column");
+
 // Test combined transformations
 const combined = translate(rotate(scale(base, 1.5), [45, 45, 45]), [10, 10, 10]);
 assert(!isEmpty(combined), "Combined transformations should not be empty");
 assert(volume(combined) > baseVolume, "Scaled and transformed object should have larger volume");
 
+// Test fused transform chains: translate -> scale -> rotate -> mirror is
+// applied as one matrix and must land where the steps would
+const chained = mirror(rotate(scale(translate(base, [2, 0, 0]), [2, 1, 1]), [0, 0, 90]), [1, 0, 0]);
+const chainedBox = boundingBox(chained);
+const baseSize = [0, 1, 2].map(i => baseBox.max[i] - baseBox.min[i]);
+assert(Math.abs(chainedBox.min[0] - baseBox.min[1]) < 1e-6 &&
+       Math.abs(chainedBox.max[0] - baseBox.max[1]) < 1e-6,
+       "Chained transforms: x extent should be the original y extent after rotate and mirror");
+assert(Math.abs((chainedBox.max[1] - chainedBox.min[1]) - 2 * baseSize[0]) < 1e-6 &&
+       Math.abs(chainedBox.min[1] - 2 * (baseBox.min[0] + 2)) < 1e-6,
+       "Chained transforms: y extent should be the scaled, shifted x extent");
+assert(Math.abs(volume(chained) - 2 * baseVolume) < 1e-6,
+       "Chained transforms should scale volume by the determinant");
+
 // Test tolerance
 const tolerance1 = getTolerance(base);
 assert(tolerance1 >= 0, "Tolerance should be non-negative");
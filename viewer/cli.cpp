@@ -0,0 +1,174 @@
+// Headless scene evaluation: dingcad_cli [-j N] [-f format] [-q quality] [-o out] scene.js...
+//
+// Each scene is evaluated into a mesh file (binary STL by default) without
+// opening a window. Scenes are spread over a pool of threads, each with its
+// own JSRuntime.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "quickjs.h"
+}
+
+#include "manifold/manifold.h"
+#include "js_bindings.h"
+#include "mesh_io.h"
+#include "scene_loader.h"
+#include "script_thread.h"
+
+namespace {
+
+struct Job {
+  std::filesystem::path scene;
+  std::filesystem::path output;
+};
+
+void PrintUsage(const char *argv0) {
+  std::cerr << "Usage: " << argv0
+            << " [-j jobs] [-f format] [-q quality] [-o output] scene.js [scene.js...]\n"
+            << "  -o output  mesh path for a single scene (its extension picks the\n"
+            << "             format), or a directory for several (default: next to\n"
+            << "             each scene)\n"
+            << "  -f format  stl, 3mf, ply or obj for derived names (default: stl)\n"
+            << "  -q quality full or preview (coarser circles, levelSet and refine;\n"
+            << "             default: full)\n"
+            << "  -j jobs    scenes evaluated in parallel (default: number of cores)\n";
+}
+
+bool RunJob(JSRuntime *runtime, ModuleLoaderData &loader, const Job &job,
+            std::string &message) {
+  auto load = LoadSceneFromFile(runtime, loader, job.scene);
+  if (!load.success) {
+    message = load.message;
+    return false;
+  }
+  std::string error;
+  if (!WriteMeshFile(load.manifold->GetMeshGL(), job.output, error)) {
+    message = error;
+    return false;
+  }
+  message = load.message + " -> " + job.output.string();
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  std::vector<std::filesystem::path> scenes;
+  std::filesystem::path output;
+  std::string format = "stl";
+  EvalQuality quality = EvalQuality::Full;
+  unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if ((arg == "-o" || arg == "-j" || arg == "-f" || arg == "-q") && i + 1 >= argc) {
+      std::cerr << arg << " needs a value\n";
+      PrintUsage(argv[0]);
+      return 2;
+    }
+    if (arg == "-o") {
+      output = argv[++i];
+    } else if (arg == "-f") {
+      format = argv[++i];
+      if (format != "stl" && format != "3mf" && format != "ply" && format != "obj") {
+        std::cerr << "-f must be one of stl, 3mf, ply, obj\n";
+        return 2;
+      }
+    } else if (arg == "-q") {
+      const std::string value = argv[++i];
+      if (value != "full" && value != "preview") {
+        std::cerr << "-q must be full or preview\n";
+        return 2;
+      }
+      quality = value == "preview" ? EvalQuality::Preview : EvalQuality::Full;
+    } else if (arg == "-j") {
+      const int value = std::atoi(argv[++i]);
+      if (value < 1) {
+        std::cerr << "-j must be at least 1\n";
+        return 2;
+      }
+      jobs = static_cast<unsigned>(value);
+    } else if (arg == "-h" || arg == "--help") {
+      PrintUsage(argv[0]);
+      return 0;
+    } else {
+      scenes.emplace_back(arg);
+    }
+  }
+  if (scenes.empty()) {
+    PrintUsage(argv[0]);
+    return 2;
+  }
+
+  std::error_code ec;
+  const bool outputIsFile = scenes.size() == 1 && !output.empty() &&
+                            !std::filesystem::is_directory(output, ec);
+  if (!output.empty() && !outputIsFile) {
+    std::filesystem::create_directories(output, ec);
+    if (ec) {
+      std::cerr << "Cannot create " << output.string() << ": " << ec.message() << "\n";
+      return 1;
+    }
+  }
+
+  std::vector<Job> queue;
+  queue.reserve(scenes.size());
+  for (const auto &scene : scenes) {
+    Job job{std::filesystem::absolute(scene, ec), {}};
+    if (outputIsFile) {
+      job.output = output;
+    } else {
+      auto name = scene.filename();
+      name.replace_extension("." + format);
+      job.output = output.empty() ? job.scene.parent_path() / name : output / name;
+    }
+    queue.push_back(std::move(job));
+  }
+
+  std::atomic<size_t> next{0};
+  std::atomic<int> failures{0};
+  std::mutex printMutex;
+  auto work = [&]() {
+    JSRuntime *runtime = JS_NewRuntime();
+    // Workers are ScriptThreads, so scripts get QuickJS's usual stack limit.
+    JS_SetMaxStackSize(runtime, kScriptStackLimit);
+    EnsureManifoldClass(runtime);
+    SetEvalQuality(runtime, quality);
+    ModuleLoaderData loader;
+
+    for (size_t index = next++; index < queue.size(); index = next++) {
+      std::string message;
+      const bool ok = RunJob(runtime, loader, queue[index], message);
+      if (!ok) ++failures;
+      std::lock_guard<std::mutex> lock(printMutex);
+      (ok ? std::cout : std::cerr)
+          << queue[index].scene.filename().string() << ": " << message << std::endl;
+    }
+
+    ReleaseSceneContext(loader);
+    FreeBindingState(runtime);
+    JS_FreeRuntime(runtime);
+  };
+
+  const size_t threadCount = std::min<size_t>(jobs, queue.size());
+  std::vector<ScriptThread> threads;
+  threads.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; ++i) {
+    threads.emplace_back(work);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  return failures.load() == 0 ? 0 : 1;
+}
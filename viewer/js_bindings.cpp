@@ -1,19 +1,34 @@
 #include "js_bindings.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <filesystem>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "manifold/manifold.h"
 #include "manifold/polygon.h"
 #include "manifold/meshIO.h"
+#include "mesh_io.h"
+#include "parallel.h"
+#include "sdf.h"
+
 namespace {
 
 void PrintLoadMeshError(const std::string &message) {
@@ -23,11 +38,69 @@ void PrintLoadMeshError(const std::string &message) {
 }
 
 
+// A union, difference or intersection chain that has not been built yet.
+// Scripts that write `plate = difference(plate, hole)` in a loop extend the
+// chain one link per call. The first time the result is used, the whole chain
+// goes to a single BatchBoolean instead of one nested Boolean per call.
+struct PendingBoolean {
+  manifold::OpType op;
+  // Earlier links of the same chain, or null for the first link.
+  std::shared_ptr<const PendingBoolean> previous;
+  // This call's operands and their hashes. The first link also holds the
+  // chain's base.
+  std::vector<std::shared_ptr<manifold::Manifold>> operands;
+  std::vector<uint64_t> operandHashes;
+  size_t count = 0;  // operands in this link and all earlier ones
+};
+
+// `base` under a transform that has not been applied yet. Consecutive
+// translate/scale/rotate/mirror/transform calls fold into the one matrix,
+// which is applied the first time the result is used.
+struct PendingTransform {
+  std::shared_ptr<manifold::Manifold> base;
+  uint64_t baseHash = 0;
+  manifold::mat3x4 matrix;
+};
+
 struct JsManifold {
+  // Null until a pending boolean or transform is first used; read through
+  // GetJsManifold.
   std::shared_ptr<manifold::Manifold> handle;
+  // Content hash of the op graph node that produced this manifold: the op
+  // name, its argument values and the hashes of its inputs.
+  uint64_t hash = 0;
+  std::shared_ptr<const PendingBoolean> pending;
+  std::shared_ptr<const PendingTransform> pendingTransform;
+};
+
+// Results of earlier binding calls, keyed by op graph hash. The cache lives
+// as long as the JSRuntime, so a reload that rebuilds the same subtree gets
+// the previous Manifold back instead of recomputing it.
+struct GeometryCache {
+  struct Entry {
+    std::vector<std::shared_ptr<manifold::Manifold>> results;
+    uint64_t generation = 0;
+    // Hashes of the op's manifold inputs: the edges of the op graph.
+    std::vector<uint64_t> inputs;
+  };
+  std::unordered_map<uint64_t, Entry> entries;
+  uint64_t generation = 1;
+  size_t hits = 0;
+  size_t misses = 0;
+};
+
+// Native SDF expression built with the `sdf` helpers.
+struct JsSdf {
+  SdfNodePtr node;
+};
+
+struct BindingState {
+  GeometryCache geometryCache;
+  EvalQuality quality = EvalQuality::Full;
 };
 
 JSClassID g_manifoldClassId;
+JSClassID g_sdfClassId;
 
 void JsManifoldFinalizer(JSRuntime *rt, JSValue val) {
   (void)rt;
@@ -35,34 +108,148 @@ void JsManifoldFinalizer(JSRuntime *rt, JSValue val) {
   delete wrapper;
 }
 
+void JsSdfFinalizer(JSRuntime *rt, JSValue val) {
+  (void)rt;
+  delete static_cast<JsSdf *>(JS_GetOpaque(val, g_sdfClassId));
+}
+
 void EnsureManifoldClassInternal(JSRuntime *runtime) {
-  static bool idInitialised = false;
-  static bool classRegistered = false;
-  if (!idInitialised) {
+  // The class IDs are shared, but every runtime (viewer, evaluation worker)
+  // needs the classes registered on its own.
+  static std::once_flag idInitialised;
+  std::call_once(idInitialised, [&]() {
     JS_NewClassID(runtime, &g_manifoldClassId);
-    idInitialised = true;
-  }
-  if (!classRegistered) {
+    JS_NewClassID(runtime, &g_sdfClassId);
+  });
+  if (!JS_IsRegisteredClass(runtime, g_manifoldClassId)) {
     JSClassDef def{};
     def.class_name = "Manifold";
     def.finalizer = JsManifoldFinalizer;
     JS_NewClass(runtime, g_manifoldClassId, &def);
-    classRegistered = true;
+  }
+  if (!JS_IsRegisteredClass(runtime, g_sdfClassId)) {
+    JSClassDef def{};
+    def.class_name = "Sdf";
+    def.finalizer = JsSdfFinalizer;
+    JS_NewClass(runtime, g_sdfClassId, &def);
+  }
+  if (!JS_GetRuntimeOpaque(runtime)) {
+    JS_SetRuntimeOpaque(runtime, new BindingState());
   }
 }
 
-JSValue WrapManifold(JSContext *ctx, std::shared_ptr<manifold::Manifold> manifold) {
+BindingState *GetBindingState(JSRuntime *runtime) {
+  return static_cast<BindingState *>(JS_GetRuntimeOpaque(runtime));
+}
+
+GeometryCache *GetGeometryCache(JSContext *ctx) {
+  BindingState *state = GetBindingState(JS_GetRuntime(ctx));
+  return state ? &state->geometryCache : nullptr;
+}
+
+// Preview evaluation coarsens tessellation: circles get a quarter of their
+// segments, and levelSet edge lengths and refine targets double.
+constexpr double kPreviewSegmentScale = 0.25;
+constexpr double kPreviewLengthScale = 2.0;
+constexpr int kPreviewMinSegments = 8;
+
+bool IsPreview(JSContext *ctx) {
+  BindingState *state = GetBindingState(JS_GetRuntime(ctx));
+  return state && state->quality == EvalQuality::Preview;
+}
+
+// Segment count for a circle of `radius`. 0 (Manifold's default) at full
+// quality; `segments` is an explicit count from the script, scaled the same.
+int CircularSegments(JSContext *ctx, double radius, int segments = 0) {
+  if (!IsPreview(ctx)) return segments;
+  const int full = segments > 0 ? segments : manifold::Quality::GetCircularSegments(radius);
+  const int scaled = static_cast<int>(std::lround(full * kPreviewSegmentScale / 4)) * 4;
+  return std::max(std::min(full, kPreviewMinSegments), scaled);
+}
+
+// A tessellation length (edge length, tolerance) at the current quality.
+double TessellationLength(JSContext *ctx, double length) {
+  return IsPreview(ctx) ? length * kPreviewLengthScale : length;
+}
+
+// Hashes for results that depend on something the op graph cannot see, such
+// as a JS callback. They never repeat, so nothing downstream is reused.
+uint64_t NextVolatileHash() {
+  static std::atomic<uint64_t> counter{0};
+  return (1ull << 63) | counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+JSValue WrapManifold(JSContext *ctx, std::shared_ptr<manifold::Manifold> manifold,
+                     uint64_t hash) {
   JSValue obj = JS_NewObjectClass(ctx, g_manifoldClassId);
   if (JS_IsException(obj)) return obj;
-  auto *wrapper = new JsManifold{std::move(manifold)};
+  auto *wrapper = new JsManifold{std::move(manifold), hash};
   JS_SetOpaque(obj, wrapper);
   return obj;
 }
 
-JsManifold *GetJsManifold(JSContext *ctx, JSValueConst value) {
+// Stores a just-resolved result in the geometry cache like any other result.
+void CacheResolved(JSContext *ctx, const JsManifold &target, std::vector<uint64_t> inputs) {
+  GeometryCache *cache = GetGeometryCache(ctx);
+  if (cache && !(target.hash & (1ull << 63))) {
+    cache->entries[target.hash] =
+        GeometryCache::Entry{{target.handle}, cache->generation, std::move(inputs)};
+  }
+}
+
+// Applies a pending transform, or builds the BatchBoolean of a pending chain,
+// the first time the result is needed.
+void ResolvePending(JSContext *ctx, JsManifold &target) {
+  if (target.handle) return;
+  if (target.pendingTransform) {
+    const PendingTransform &pending = *target.pendingTransform;
+    target.handle = std::make_shared<manifold::Manifold>(pending.base->Transform(pending.matrix));
+    CacheResolved(ctx, target, {pending.baseHash});
+    return;
+  }
+  if (!target.pending) return;
+  std::vector<const PendingBoolean *> links;
+  for (const PendingBoolean *link = target.pending.get(); link; link = link->previous.get()) {
+    links.push_back(link);
+  }
+  std::vector<manifold::Manifold> operands;
+  std::vector<uint64_t> operandHashes;
+  operands.reserve(target.pending->count);
+  operandHashes.reserve(target.pending->count);
+  for (auto it = links.rbegin(); it != links.rend(); ++it) {
+    for (const auto &operand : (*it)->operands) operands.push_back(*operand);
+    operandHashes.insert(operandHashes.end(), (*it)->operandHashes.begin(),
+                         (*it)->operandHashes.end());
+  }
+  target.handle = std::make_shared<manifold::Manifold>(
+      manifold::Manifold::BatchBoolean(operands, target.pending->op));
+  target.pending.reset();  // links still shared by later chains stay alive
+  CacheResolved(ctx, target, std::move(operandHashes));
+}
+
+// Returns the wrapper without building a pending boolean, for ops that can
+// extend the chain instead.
+JsManifold *GetJsManifoldDeferred(JSContext *ctx, JSValueConst value) {
   return static_cast<JsManifold *>(JS_GetOpaque2(ctx, value, g_manifoldClassId));
 }
 
+// Wraps a result whose geometry is still pending.
+JSValue WrapUnresolved(JSContext *ctx, JsManifold *wrapper) {
+  JSValue obj = JS_NewObjectClass(ctx, g_manifoldClassId);
+  if (JS_IsException(obj)) {
+    delete wrapper;
+    return obj;
+  }
+  JS_SetOpaque(obj, wrapper);
+  return obj;
+}
+
+JsManifold *GetJsManifold(JSContext *ctx, JSValueConst value) {
+  JsManifold *jsManifold = GetJsManifoldDeferred(ctx, value);
+  if (jsManifold) ResolvePending(ctx, *jsManifold);
+  return jsManifold;
+}
+
 std::shared_ptr<manifold::Manifold> GetManifoldHandleInternal(JSContext *ctx,
                                                               JSValueConst value) {
   JsManifold *jsManifold = GetJsManifold(ctx, value);
@@ -70,7 +257,424 @@ std::shared_ptr<manifold::Manifold> GetManifoldHandleInternal(JSContext *ctx,
   return jsManifold->handle;
 }
 
+// Builds the op graph key for one binding call. Every argument that affects
+// the result must be added; inputs contribute their own node hash.
+class OpKey {
+ public:
+  explicit OpKey(const char *op) { Add(std::string(op)); }
+
+  OpKey &Add(double value) {
+    if (value == 0.0) value = 0.0;  // fold -0 into +0
+    if (std::isnan(value)) value = std::numeric_limits<double>::quiet_NaN();
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    Mix(bits);
+    return *this;
+  }
+  OpKey &Add(int64_t value) {
+    Mix(static_cast<uint64_t>(value));
+    return *this;
+  }
+  OpKey &Add(bool value) {
+    Mix(value ? 1 : 0);
+    return *this;
+  }
+  OpKey &Add(const std::string &value) {
+    Mix(value.size());
+    uint64_t fnv = 0xcbf29ce484222325ull;
+    for (unsigned char c : value) {
+      fnv = (fnv ^ c) * 0x100000001b3ull;
+    }
+    Mix(fnv);
+    material_ += value;
+    return *this;
+  }
+  OpKey &Add(const JsManifold *input) {
+    if (input->hash & (1ull << 63)) volatile_ = true;
+    inputs_.push_back(input->hash);
+    Mix(input->hash);
+    return *this;
+  }
+  template <size_t N>
+  OpKey &Add(const std::array<double, N> &values) {
+    for (double v : values) Add(v);
+    return *this;
+  }
+  OpKey &Add(const manifold::vec2 &v) { return Add(v.x).Add(v.y); }
+  OpKey &Add(const manifold::vec3 &v) { return Add(v.x).Add(v.y).Add(v.z); }
+  OpKey &Add(const manifold::Polygons &polys) {
+    Mix(polys.size());
+    for (const auto &loop : polys) {
+      Mix(loop.size());
+      for (const auto &pt : loop) Add(pt);
+    }
+    return *this;
+  }
+  OpKey &Add(const std::vector<manifold::vec3> &points) {
+    Mix(points.size());
+    for (const auto &pt : points) Add(pt);
+    return *this;
+  }
+  // The whole expression, not its 64-bit node hash, so the on-disk cache can
+  // tell apart trees whose hashes collide.
+  OpKey &Add(const SdfNode &node) {
+    Add(static_cast<int64_t>(node.op));
+    Mix(node.params.size());
+    for (double param : node.params) Add(param);
+    Mix(node.children.size());
+    for (const auto &child : node.children) Add(*child);
+    return *this;
+  }
+
+  // Marks an expensive op whose result is also kept in the on-disk mesh
+  // cache, so it survives restarts and is shared with the CLI. Writing the
+  // mesh costs more than cheap ops take, so only mark ops worth it.
+  OpKey &Persist() {
+    persistent_ = true;
+    return *this;
+  }
+
+  // Marks an op whose result is the same at every evaluation quality (e.g.
+  // reading a file), so preview and full evaluations share its entry. Every
+  // other key is salted with the quality.
+  OpKey &QualityIndependent() {
+    qualityIndependent_ = true;
+    return *this;
+  }
+
+  // True once any input came from a volatile (uncacheable) node.
+  bool IsVolatile() const { return volatile_; }
+  bool IsPersistent() const { return persistent_; }
+  bool IsQualityIndependent() const { return qualityIndependent_; }
+  const std::vector<uint64_t> &Inputs() const { return inputs_; }
+  // Everything the key was built from (inputs by their hashes), which the
+  // on-disk cache compares in full instead of trusting the 64-bit hash.
+  const std::string &Material() const { return material_; }
+  void ReserveInputs(size_t count) { inputs_.reserve(inputs_.size() + count); }
+
+  // `salt` (0 for none) separates otherwise equal keys, e.g. by quality.
+  uint64_t Value(uint64_t salt = 0) const {
+    // splitmix64 finaliser; keep the top bit clear for stable hashes.
+    uint64_t z = salt ? Mixed(state_, salt) : state_;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z ^= z >> 31;
+    return z & ~(1ull << 63);
+  }
+
+ private:
+  static uint64_t Mixed(uint64_t state, uint64_t value) {
+    return state ^ (value + 0x9e3779b97f4a7c15ull + (state << 6) + (state >> 2));
+  }
+  void Mix(uint64_t value) {
+    state_ = Mixed(state_, value);
+    material_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  uint64_t state_ = 0x84222325cbf29ce4ull;
+  bool volatile_ = false;
+  bool persistent_ = false;
+  bool qualityIndependent_ = false;
+  std::vector<uint64_t> inputs_;
+  std::string material_;
+};
+
+// Op graph hash of `key` in this evaluation: a fresh volatile hash when an
+// input is volatile, and salted at preview quality so coarse results never
+// stand in for full ones (in memory, on disk, or behind cached()).
+uint64_t NodeHash(JSContext *ctx, const OpKey &key) {
+  if (key.IsVolatile()) return NextVolatileHash();
+  constexpr uint64_t kPreviewSalt = 0x70726576696577ull;  // "preview"
+  return key.Value(IsPreview(ctx) && !key.IsQualityIndependent() ? kPreviewSalt : 0);
+}
+
+#ifdef DINGCAD_MESH_CACHE_DIR
+// Bump whenever a persisted op's results change (a fix to an op, a new
+// default), so meshes written by older builds are not served again.
+constexpr int64_t kMeshCacheSemantics = 1;
+// The least recently used meshes are deleted beyond this.
+constexpr uintmax_t kMeshCacheMaxBytes = uintmax_t{2} << 30;
+
+// Name a result is stored under on disk: its op graph hash, salted with
+// kMeshCacheSemantics.
+uint64_t PersistedKey(uint64_t hash) {
+  return OpKey("persisted").Add(static_cast<int64_t>(hash)).Add(kMeshCacheSemantics).Value();
+}
+
+// Key material checked against the file itself: the op's own key material
+// plus everything that salted its hash.
+std::string PersistedMaterial(JSContext *ctx, const OpKey &key) {
+  std::string material = key.Material();
+  const int64_t salts[2] = {kMeshCacheSemantics,
+                            IsPreview(ctx) && !key.IsQualityIndependent() ? 1 : 0};
+  material.append(reinterpret_cast<const char *>(salts), sizeof(salts));
+  return material;
+}
+
+// On-disk copy of a result, named after its persisted key.
+std::filesystem::path MeshCacheFile(uint64_t key) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.mesh", static_cast<unsigned long long>(key));
+  return std::filesystem::path(DINGCAD_MESH_CACHE_DIR) / name;
+}
+
+// Writes persisted results on a background thread, so evaluation never waits
+// for lazy results, the mesh extraction or the disk (results that fail are
+// skipped), then trims the cache directory to
+// kMeshCacheMaxBytes. Shared by every runtime in the process; queued writes
+// are finished at exit.
+class MeshCacheWriter {
+ public:
+  static MeshCacheWriter &Instance() {
+    static MeshCacheWriter writer;
+    return writer;
+  }
+
+  void Enqueue(std::shared_ptr<const manifold::Manifold> result, uint64_t name,
+               std::string material) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back({std::move(result), name, std::move(material)});
+    }
+    wake_.notify_one();
+  }
+
+ private:
+  MeshCacheWriter() : thread_([this]() { Run(); }) {}
+  ~MeshCacheWriter() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+  }
+
+  struct Job {
+    std::shared_ptr<const manifold::Manifold> result;
+    uint64_t name = 0;
+    std::string material;
+  };
+
+  void Run() {
+    for (;;) {
+      Job job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) break;
+        job = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      if (job.result->Status() != manifold::Manifold::Error::NoError) continue;
+      if (WriteMeshCache(job.result->GetMeshGL(), job.material, MeshCacheFile(job.name))) {
+        PruneMeshCache(DINGCAD_MESH_CACHE_DIR, kMeshCacheMaxBytes);
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<Job> queue_;
+  bool stopping_ = false;
+  std::thread thread_;  // last, so it starts after the members above
+};
+#endif
+
+// Results cached under `hash`, marked as used by this evaluation, or null.
+const std::vector<std::shared_ptr<manifold::Manifold>> *FindCached(GeometryCache *cache,
+                                                                  uint64_t hash) {
+  if (!cache) return nullptr;
+  auto it = cache->entries.find(hash);
+  if (it == cache->entries.end()) return nullptr;
+  it->second.generation = cache->generation;
+  ++cache->hits;
+  return &it->second.results;
+}
+
+// Looks the key up in the runtime's geometry cache, then in the on-disk cache
+// for persistent keys, and only runs `compute` (returning a
+// std::vector<manifold::Manifold>) on a miss.
+template <typename Compute>
+std::vector<std::shared_ptr<manifold::Manifold>> MemoizedResults(
+    JSContext *ctx, const OpKey &key, uint64_t &hashOut, Compute &&compute) {
+  GeometryCache *cache = key.IsVolatile() ? nullptr : GetGeometryCache(ctx);
+  hashOut = NodeHash(ctx, key);
+  if (auto *cached = FindCached(cache, hashOut)) return *cached;
+  std::vector<std::shared_ptr<manifold::Manifold>> results;
+#ifdef DINGCAD_MESH_CACHE_DIR
+  const bool persistent = cache && key.IsPersistent();
+  const uint64_t diskKey = persistent ? PersistedKey(hashOut) : 0;
+  const std::string material = persistent ? PersistedMaterial(ctx, key) : std::string();
+  manifold::MeshGL stored;
+  if (persistent && ReadMeshCache(MeshCacheFile(diskKey), material, stored)) {
+    // The stored runs keep the original IDs of the process that wrote them;
+    // move this process's counter past them so new IDs do not collide.
+    if (!stored.runOriginalID.empty()) {
+      const uint32_t last =
+          *std::max_element(stored.runOriginalID.begin(), stored.runOriginalID.end());
+      const uint32_t next = manifold::Manifold::ReserveIDs(0);
+      if (next <= last) manifold::Manifold::ReserveIDs(last + 1 - next);
+    }
+    auto restored = std::make_shared<manifold::Manifold>(stored);
+    if (restored->Status() == manifold::Manifold::Error::NoError) {
+      results.push_back(std::move(restored));
+    }
+  }
+#endif
+  if (results.empty()) {
+    for (auto &mf : compute()) {
+      results.push_back(std::make_shared<manifold::Manifold>(std::move(mf)));
+    }
+#ifdef DINGCAD_MESH_CACHE_DIR
+    // No Status() here: it would evaluate a lazy result (e.g. a large
+    // batchBoolean) on the JS thread; the writer checks it instead.
+    if (persistent && results.size() == 1) {
+      MeshCacheWriter::Instance().Enqueue(results.front(), diskKey, material);
+    }
+#endif
+  }
+  if (cache) {
+    ++cache->misses;
+    cache->entries[hashOut] = GeometryCache::Entry{results, cache->generation, key.Inputs()};
+  }
+  return results;
+}
+
+template <typename Compute>
+JSValue Memoized(JSContext *ctx, const OpKey &key, Compute &&compute) {
+  uint64_t hash = 0;
+  auto results = MemoizedResults(ctx, key, hash, [&]() {
+    std::vector<manifold::Manifold> single;
+    single.push_back(compute());
+    return single;
+  });
+  return WrapManifold(ctx, std::move(results.front()), hash);
+}
+
+// Float32Array/Float64Array contents, read in place from the backing buffer.
+struct FloatView {
+  const void *data = nullptr;
+  size_t length = 0;
+  bool isFloat32 = false;
+
+  double operator[](size_t i) const {
+    return isFloat32 ? static_cast<const float *>(data)[i]
+                     : static_cast<const double *>(data)[i];
+  }
+};
+
+bool IsFloatArray(JSValueConst value) {
+  const int type = JS_GetTypedArrayType(value);
+  return type == JS_TYPED_ARRAY_FLOAT32 || type == JS_TYPED_ARRAY_FLOAT64;
+}
+
+bool GetTypedArrayBytes(JSContext *ctx, JSValueConst value, const uint8_t *&data,
+                        size_t &length, size_t &elementSize) {
+  size_t offset = 0;
+  size_t byteLength = 0;
+  JSValue buffer = JS_GetTypedArrayBuffer(ctx, value, &offset, &byteLength, &elementSize);
+  if (JS_IsException(buffer)) return false;
+  size_t bufferSize = 0;
+  const uint8_t *bytes = JS_GetArrayBuffer(ctx, &bufferSize, buffer);
+  // The typed array keeps its own reference to the buffer.
+  JS_FreeValue(ctx, buffer);
+  if (!bytes) return false;  // detached; QuickJS has thrown
+  data = bytes + offset;
+  length = byteLength / elementSize;
+  return true;
+}
+
+bool GetFloatView(JSContext *ctx, JSValueConst value, FloatView &out) {
+  const uint8_t *data = nullptr;
+  size_t elementSize = 0;
+  if (!GetTypedArrayBytes(ctx, value, data, out.length, elementSize)) return false;
+  out.data = data;
+  out.isFloat32 = elementSize == sizeof(float);
+  return true;
+}
+
+bool ReadFloatArray(JSContext *ctx, JSValueConst value, double *out, size_t count,
+                    const char *lengthError) {
+  FloatView view;
+  if (!GetFloatView(ctx, value, view)) return false;
+  if (view.length < count) {
+    JS_ThrowTypeError(ctx, "%s", lengthError);
+    return false;
+  }
+  for (size_t i = 0; i < count; ++i) out[i] = view[i];
+  return true;
+}
+
+// Flat point input is either a bare float array or a {points, loopOffsets?}
+// object. Returns the points array, JS_UNDEFINED if `value` is neither, or
+// JS_EXCEPTION.
+JSValue GetFlatPoints(JSContext *ctx, JSValueConst value) {
+  if (IsFloatArray(value)) return JS_DupValue(ctx, value);
+  if (!JS_IsObject(value) || JS_IsArray(value)) return JS_UNDEFINED;
+  JSValue points = JS_GetPropertyStr(ctx, value, "points");
+  if (JS_IsException(points) || IsFloatArray(points)) return points;
+  JS_FreeValue(ctx, points);
+  return JS_UNDEFINED;
+}
+
+// Loop start indices (in points) from a Uint32Array/Int32Array or a plain
+// array; they must ascend and stay within `numPoints`.
+bool GetLoopOffsets(JSContext *ctx, JSValueConst value, size_t numPoints,
+                    std::vector<size_t> &out) {
+  std::vector<size_t> offsets;
+  const int type = JS_GetTypedArrayType(value);
+  if (type == JS_TYPED_ARRAY_UINT32 || type == JS_TYPED_ARRAY_INT32) {
+    const uint8_t *data = nullptr;
+    size_t length = 0;
+    size_t elementSize = 0;
+    if (!GetTypedArrayBytes(ctx, value, data, length, elementSize)) return false;
+    offsets.reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+      int64_t offset = type == JS_TYPED_ARRAY_UINT32
+                           ? reinterpret_cast<const uint32_t *>(data)[i]
+                           : reinterpret_cast<const int32_t *>(data)[i];
+      if (offset < 0) offset = static_cast<int64_t>(numPoints) + 1;  // rejected below
+      offsets.push_back(static_cast<size_t>(offset));
+    }
+  } else if (JS_IsArray(value)) {
+    JSValue lengthVal = JS_GetPropertyStr(ctx, value, "length");
+    uint32_t length = 0;
+    if (JS_ToUint32(ctx, &length, lengthVal) < 0) {
+      JS_FreeValue(ctx, lengthVal);
+      return false;
+    }
+    JS_FreeValue(ctx, lengthVal);
+    offsets.reserve(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      JSValue element = JS_GetPropertyUint32(ctx, value, i);
+      uint32_t offset = 0;
+      if (JS_ToUint32(ctx, &offset, element) < 0) {
+        JS_FreeValue(ctx, element);
+        return false;
+      }
+      JS_FreeValue(ctx, element);
+      offsets.push_back(offset);
+    }
+  } else {
+    JS_ThrowTypeError(ctx, "loopOffsets must be a Uint32Array or array of indices");
+    return false;
+  }
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    if (offsets[i] > numPoints || (i > 0 && offsets[i] < offsets[i - 1])) {
+      JS_ThrowRangeError(ctx, "loopOffsets must ascend and stay within points");
+      return false;
+    }
+  }
+  if (offsets.empty() || offsets.front() != 0) offsets.insert(offsets.begin(), 0);
+  out = std::move(offsets);
+  return true;
+}
+
 bool GetVec3(JSContext *ctx, JSValueConst value, std::array<double, 3> &out) {
+  if (IsFloatArray(value)) {
+    return ReadFloatArray(ctx, value, out.data(), 3, "vector requires three entries");
+  }
   if (!JS_IsArray(value)) {
     JS_ThrowTypeError(ctx, "expected array of three numbers");
     return false;
@@ -92,6 +696,9 @@ bool GetVec3(JSContext *ctx, JSValueConst value, std::array<double, 3> &out) {
 }
 
 bool GetVec2(JSContext *ctx, JSValueConst value, std::array<double, 2> &out) {
+  if (IsFloatArray(value)) {
+    return ReadFloatArray(ctx, value, out.data(), 2, "vector requires two entries");
+  }
   if (!JS_IsArray(value)) {
     JS_ThrowTypeError(ctx, "expected array of two numbers");
     return false;
@@ -131,9 +738,10 @@ bool GetMat3x4(JSContext *ctx, JSValueConst value, manifold::mat3x4 &out) {
     }
     JS_FreeValue(ctx, element);
   }
+  // Entries are row-major; linalg matrices are indexed [column][row].
   for (int row = 0; row < 3; ++row) {
     for (int col = 0; col < 4; ++col) {
-      out[row][col] = entries[row * 4 + col];
+      out[col][row] = entries[row * 4 + col];
     }
   }
   return true;
@@ -154,10 +762,52 @@ JSValue Vec2ToJs(JSContext *ctx, const manifold::vec2 &v) {
   return arr;
 }
 
+// Flat polygons hold x,y pairs; loop i runs from offsets[i] up to the next
+// offset. Without offsets all points form one loop.
+bool FlatToPolygons(JSContext *ctx, JSValueConst points, JSValueConst offsets,
+                    manifold::Polygons &out) {
+  FloatView view;
+  if (!GetFloatView(ctx, points, view)) return false;
+  if (view.length % 2 != 0) {
+    JS_ThrowRangeError(ctx, "flat polygon points must be x,y pairs");
+    return false;
+  }
+  const size_t numPoints = view.length / 2;
+  std::vector<size_t> starts{0};
+  if (!JS_IsUndefined(offsets) && !JS_IsNull(offsets) &&
+      !GetLoopOffsets(ctx, offsets, numPoints, starts)) {
+    return false;
+  }
+  manifold::Polygons result;
+  result.reserve(starts.size());
+  for (size_t i = 0; i < starts.size(); ++i) {
+    const size_t end = i + 1 < starts.size() ? starts[i + 1] : numPoints;
+    if (end == starts[i]) continue;
+    manifold::SimplePolygon loop;
+    loop.reserve(end - starts[i]);
+    for (size_t p = starts[i]; p < end; ++p) {
+      loop.push_back(manifold::vec2{view[2 * p], view[2 * p + 1]});
+    }
+    result.push_back(std::move(loop));
+  }
+  out = std::move(result);
+  return true;
+}
+
 bool JsValueToPolygons(JSContext *ctx, JSValueConst value,
                        manifold::Polygons &out) {
+  JSValue flat = GetFlatPoints(ctx, value);
+  if (JS_IsException(flat)) return false;
+  if (!JS_IsUndefined(flat)) {
+    JSValue offsets = IsFloatArray(value) ? JS_UNDEFINED
+                                          : JS_GetPropertyStr(ctx, value, "loopOffsets");
+    const bool ok = !JS_IsException(offsets) && FlatToPolygons(ctx, flat, offsets, out);
+    JS_FreeValue(ctx, offsets);
+    JS_FreeValue(ctx, flat);
+    return ok;
+  }
   if (!JS_IsArray(value)) {
-    JS_ThrowTypeError(ctx, "polygons must be an array of loops");
+    JS_ThrowTypeError(ctx, "polygons must be an array of loops or flat points");
     return false;
   }
   JSValue lengthVal = JS_GetPropertyStr(ctx, value, "length");
@@ -224,8 +874,59 @@ JSValue PolygonsToJs(JSContext *ctx, const manifold::Polygons &polys) {
   return arr;
 }
 
+void FreeArrayBufferData(JSRuntime *rt, void *, void *ptr) { js_free_rt(rt, ptr); }
+
+// One ArrayBuffer that several typed-array views below share, so a result
+// costs a single allocation on the QuickJS heap.
+JSValue NewArrayBuffer(JSContext *ctx, size_t bytes, uint8_t *&data) {
+  data = static_cast<uint8_t *>(js_malloc(ctx, std::max<size_t>(bytes, 1)));
+  if (!data) return JS_EXCEPTION;
+  return JS_NewArrayBuffer(ctx, data, bytes, FreeArrayBufferData, nullptr, false);
+}
+
+JSValue NewTypedArrayView(JSContext *ctx, JSValueConst buffer, size_t byteOffset,
+                          size_t length, JSTypedArrayEnum type) {
+  JSValue args[3] = {JS_DupValue(ctx, buffer),
+                     JS_NewInt64(ctx, static_cast<int64_t>(byteOffset)),
+                     JS_NewInt64(ctx, static_cast<int64_t>(length))};
+  JSValue view = JS_NewTypedArray(ctx, 3, args, type);
+  JS_FreeValue(ctx, args[0]);
+  return view;
+}
+
+// {points: Float64Array of x,y pairs, loopOffsets: Uint32Array of loop
+// starts}; accepted back by extrude/revolve.
+JSValue PolygonsToFlatJs(JSContext *ctx, const manifold::Polygons &polys) {
+  size_t numPoints = 0;
+  for (const auto &loop : polys) numPoints += loop.size();
+  const size_t pointBytes = numPoints * 2 * sizeof(double);
+  uint8_t *data = nullptr;
+  JSValue buffer = NewArrayBuffer(ctx, pointBytes + polys.size() * sizeof(uint32_t), data);
+  if (JS_IsException(buffer)) return buffer;
+  auto *coords = reinterpret_cast<double *>(data);
+  auto *offsets = reinterpret_cast<uint32_t *>(data + pointBytes);
+  size_t p = 0;
+  for (size_t i = 0; i < polys.size(); ++i) {
+    offsets[i] = static_cast<uint32_t>(p);
+    for (const auto &pt : polys[i]) {
+      coords[2 * p] = pt.x;
+      coords[2 * p + 1] = pt.y;
+      ++p;
+    }
+  }
+  JSValue obj = JS_NewObject(ctx);
+  JS_SetPropertyStr(ctx, obj, "points",
+                    NewTypedArrayView(ctx, buffer, 0, numPoints * 2, JS_TYPED_ARRAY_FLOAT64));
+  JS_SetPropertyStr(ctx, obj, "loopOffsets",
+                    NewTypedArrayView(ctx, buffer, pointBytes, polys.size(), JS_TYPED_ARRAY_UINT32));
+  JS_FreeValue(ctx, buffer);
+  return obj;
+}
+
+// Inputs of an n-ary op, as the wrappers' shared handles. Nothing is copied
+// here, so a call served from the cache costs one handle per input.
 bool CollectManifoldArgs(JSContext *ctx, int argc, JSValueConst *argv,
-                         std::vector<manifold::Manifold> &out) {
+                         std::vector<std::shared_ptr<manifold::Manifold>> &out, OpKey &key) {
   if (argc == 0) {
     JS_ThrowTypeError(ctx, "expected at least one manifold");
     return false;
@@ -240,40 +941,77 @@ bool CollectManifoldArgs(JSContext *ctx, int argc, JSValueConst *argv,
     }
     JS_FreeValue(ctx, lengthVal);
     out.reserve(len);
+    key.ReserveInputs(len);
     for (uint32_t i = 0; i < len; ++i) {
       JSValue itemVal = JS_GetPropertyUint32(ctx, arr, i);
       if (JS_IsException(itemVal)) return false;
       JsManifold *jsManifold = GetJsManifold(ctx, itemVal);
       JS_FreeValue(ctx, itemVal);
       if (!jsManifold) return false;
-      out.push_back(*jsManifold->handle);
+      key.Add(jsManifold);
+      out.push_back(jsManifold->handle);
     }
     return true;
   }
   out.reserve(argc);
+  key.ReserveInputs(argc);
   for (int i = 0; i < argc; ++i) {
     JsManifold *jsManifold = GetJsManifold(ctx, argv[i]);
     if (!jsManifold) return false;
-    out.push_back(*jsManifold->handle);
+    key.Add(jsManifold);
+    out.push_back(jsManifold->handle);
   }
   return true;
 }
 
-JSValue ManifoldVectorToJsArray(JSContext *ctx,
-                                std::vector<manifold::Manifold> manifolds) {
+// The vector Manifold's n-ary ops take, built only when the op runs. Each
+// element shares its input's CSG node.
+std::vector<manifold::Manifold> ToManifolds(
+    const std::vector<std::shared_ptr<manifold::Manifold>> &handles) {
+  std::vector<manifold::Manifold> manifolds;
+  manifolds.reserve(handles.size());
+  for (const auto &handle : handles) manifolds.push_back(*handle);
+  return manifolds;
+}
+
+JSValue ManifoldVectorToJsArray(
+    JSContext *ctx, std::vector<std::shared_ptr<manifold::Manifold>> manifolds,
+    uint64_t hash) {
   JSValue arr = JS_NewArray(ctx);
   uint32_t idx = 0;
   for (auto &mf : manifolds) {
-    auto wrapped = std::make_shared<manifold::Manifold>(std::move(mf));
-    JS_SetPropertyUint32(ctx, arr, idx++, WrapManifold(ctx, std::move(wrapped)));
+    const uint64_t partHash =
+        (hash & (1ull << 63))
+            ? NextVolatileHash()
+            : OpKey("part").Add(static_cast<int64_t>(hash)).Add(static_cast<int64_t>(idx)).Value();
+    JS_SetPropertyUint32(ctx, arr, idx++, WrapManifold(ctx, std::move(mf), partHash));
   }
   return arr;
 }
 
 bool JsArrayToVec3List(JSContext *ctx, JSValueConst value,
                        std::vector<manifold::vec3> &out) {
+  JSValue flat = GetFlatPoints(ctx, value);
+  if (JS_IsException(flat)) return false;
+  if (!JS_IsUndefined(flat)) {
+    FloatView view;
+    const bool ok = GetFloatView(ctx, flat, view);
+    JS_FreeValue(ctx, flat);
+    if (!ok) return false;
+    if (view.length % 3 != 0) {
+      JS_ThrowRangeError(ctx, "flat points must be x,y,z triples");
+      return false;
+    }
+    std::vector<manifold::vec3> result;
+    result.reserve(view.length / 3);
+    for (size_t i = 0; i < view.length; i += 3) {
+      result.push_back(manifold::vec3{view[i], view[i + 1], view[i + 2]});
+    }
+    out = std::move(result);
+    return true;
+  }
   if (!JS_IsArray(value)) {
-    JS_ThrowTypeError(ctx, "expected array of [x,y,z] points");
+    JS_ThrowTypeError(ctx, "expected array of [x,y,z] points or flat points");
     return false;
   }
   JSValue lengthVal = JS_GetPropertyStr(ctx, value, "length");
@@ -429,8 +1167,11 @@ JSValue JsCube(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
     }
     JS_FreeValue(ctx, centerVal);
   }
-  auto manifold = std::make_shared<manifold::Manifold>(manifold::Manifold::Cube({sx, sy, sz}, center));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("cube");
+  key.Add(sx).Add(sy).Add(sz).Add(center);
+  return Memoized(ctx, key, [&]() {
+    return manifold::Manifold::Cube({sx, sy, sz}, center);
+  });
 }
 
 JSValue JsSphere(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -445,8 +1186,10 @@ JSValue JsSphere(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
     }
     JS_FreeValue(ctx, radiusVal);
   }
-  auto manifold = std::make_shared<manifold::Manifold>(manifold::Manifold::Sphere(radius, 0));
-  return WrapManifold(ctx, std::move(manifold));
+  const int segments = CircularSegments(ctx, radius);
+  OpKey key("sphere");
+  key.Add(radius).Add(static_cast<int64_t>(segments));
+  return Memoized(ctx, key, [&]() { return manifold::Manifold::Sphere(radius, segments); });
 }
 
 JSValue JsCylinder(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -494,9 +1237,12 @@ JSValue JsCylinder(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
     JS_FreeValue(ctx, centerVal);
   }
   double radiusHigh = (radiusTop < 0.0) ? radius : radiusTop;
-  auto manifold = std::make_shared<manifold::Manifold>(
-      manifold::Manifold::Cylinder(height, radius, radiusHigh, 0, center));
-  return WrapManifold(ctx, std::move(manifold));
+  const int segments = CircularSegments(ctx, std::max(radius, radiusHigh));
+  OpKey key("cylinder");
+  key.Add(height).Add(radius).Add(radiusHigh).Add(center).Add(static_cast<int64_t>(segments));
+  return Memoized(ctx, key, [&]() {
+    return manifold::Manifold::Cylinder(height, radius, radiusHigh, segments, center);
+  });
 }
 
 JSValue JsBoolean(JSContext *ctx, int argc, JSValueConst *argv,
@@ -504,26 +1250,42 @@ JSValue JsBoolean(JSContext *ctx, int argc, JSValueConst *argv,
   if (argc < 2) {
     return JS_ThrowTypeError(ctx, "boolean operation requires at least two manifolds");
   }
-  JsManifold *base = GetJsManifold(ctx, argv[0]);
-  if (!base) return JS_EXCEPTION;
-  std::shared_ptr<manifold::Manifold> result =
-      std::make_shared<manifold::Manifold>(*base->handle);
-  for (int i = 1; i < argc; ++i) {
-    JsManifold *next = GetJsManifold(ctx, argv[i]);
+  std::vector<JsManifold *> inputs;
+  inputs.reserve(argc);
+  OpKey key("boolean");
+  key.Add(static_cast<int64_t>(op)).ReserveInputs(argc);
+  for (int i = 0; i < argc; ++i) {
+    JsManifold *next = GetJsManifoldDeferred(ctx, argv[i]);
     if (!next) return JS_EXCEPTION;
-    switch (op) {
-      case manifold::OpType::Add:
-        result = std::make_shared<manifold::Manifold>(*result + *next->handle);
-        break;
-      case manifold::OpType::Subtract:
-        result = std::make_shared<manifold::Manifold>(*result - *next->handle);
-        break;
-      case manifold::OpType::Intersect:
-        result = std::make_shared<manifold::Manifold>(*result ^ *next->handle);
-        break;
-    }
+    key.Add(next);
+    inputs.push_back(next);
+  }
+  GeometryCache *cache = key.IsVolatile() ? nullptr : GetGeometryCache(ctx);
+  const uint64_t hash = NodeHash(ctx, key);
+  if (auto *cached = FindCached(cache, hash)) return WrapManifold(ctx, cached->front(), hash);
+
+  // Nothing is computed here: the result is a link appended to the first
+  // input's chain when it is still pending with the same op, or a new chain.
+  // A resolved first input starts the new chain as its base, so queries
+  // inside a loop never make the next link rebuild everything before them.
+  auto link = std::make_shared<PendingBoolean>();
+  link->op = op;
+  size_t first = 0;
+  if (!inputs[0]->handle && inputs[0]->pending && inputs[0]->pending->op == op) {
+    link->previous = inputs[0]->pending;
+    first = 1;
   }
-  return WrapManifold(ctx, std::move(result));
+  link->operands.reserve(inputs.size() - first);
+  link->operandHashes.reserve(inputs.size() - first);
+  for (size_t i = first; i < inputs.size(); ++i) {
+    ResolvePending(ctx, *inputs[i]);
+    link->operands.push_back(inputs[i]->handle);
+    link->operandHashes.push_back(inputs[i]->hash);
+  }
+  link->count = (link->previous ? link->previous->count : 0) + link->operands.size();
+  if (cache) ++cache->misses;
+
+  return WrapUnresolved(ctx, new JsManifold{nullptr, hash, std::move(link), nullptr});
 }
 
 JSValue JsUnion(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
@@ -538,24 +1300,84 @@ JSValue JsIntersection(JSContext *ctx, JSValueConst this_val, int argc, JSValueC
   return JsBoolean(ctx, argc, argv, manifold::OpType::Intersect);
 }
 
+// sin of an angle in degrees, exact at multiples of 90 like Manifold's own
+// Rotate, so axis-aligned rotations stay exactly axis-aligned.
+double SinDegrees(double degrees) {
+  if (!std::isfinite(degrees)) return std::sin(degrees);
+  if (degrees < 0.0) return -SinDegrees(-degrees);
+  int quadrant = 0;
+  const double x = std::remquo(degrees, 90.0, &quadrant) * manifold::kPi / 180;
+  switch (quadrant & 3) {
+    case 0: return std::sin(x);
+    case 1: return std::cos(x);
+    case 2: return -std::sin(x);
+    default: return -std::cos(x);
+  }
+}
+
+double CosDegrees(double degrees) { return SinDegrees(degrees + 90.0); }
+
+manifold::mat3x4 AffineMatrix(const manifold::vec3 &x, const manifold::vec3 &y,
+                              const manifold::vec3 &z, const manifold::vec3 &offset = {0, 0, 0}) {
+  return manifold::mat3x4(x, y, z, offset);
+}
+
+// outer applied after inner, for 3x4 affine matrices stored as columns.
+manifold::mat3x4 ComposeAffine(const manifold::mat3x4 &outer, const manifold::mat3x4 &inner) {
+  manifold::mat3x4 out = AffineMatrix({0, 0, 0}, {0, 0, 0}, {0, 0, 0});
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 3; ++row) {
+      double value = col == 3 ? outer[3][row] : 0.0;
+      for (int k = 0; k < 3; ++k) value += outer[k][row] * inner[col][k];
+      out[col][row] = value;
+    }
+  }
+  return out;
+}
+
+// Shared tail of the transform bindings. Nothing is computed: `matrix` is
+// folded into the target's pending transform, or starts one.
+JSValue DeferTransform(JSContext *ctx, JsManifold *target, const OpKey &key,
+                       const manifold::mat3x4 &matrix) {
+  GeometryCache *cache = key.IsVolatile() ? nullptr : GetGeometryCache(ctx);
+  const uint64_t hash = NodeHash(ctx, key);
+  if (auto *cached = FindCached(cache, hash)) return WrapManifold(ctx, cached->front(), hash);
+
+  auto pending = std::make_shared<PendingTransform>();
+  if (target->pendingTransform) {
+    pending->base = target->pendingTransform->base;
+    pending->baseHash = target->pendingTransform->baseHash;
+    pending->matrix = ComposeAffine(matrix, target->pendingTransform->matrix);
+  } else {
+    ResolvePending(ctx, *target);
+    pending->base = target->handle;
+    pending->baseHash = target->hash;
+    pending->matrix = matrix;
+  }
+  if (cache) ++cache->misses;
+  return WrapUnresolved(ctx, new JsManifold{nullptr, hash, nullptr, std::move(pending)});
+}
+
 JSValue JsTranslate(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   if (argc < 2) {
     return JS_ThrowTypeError(ctx, "translate expects (manifold, [x,y,z])");
   }
-  JsManifold *target = GetJsManifold(ctx, argv[0]);
+  JsManifold *target = GetJsManifoldDeferred(ctx, argv[0]);
   if (!target) return JS_EXCEPTION;
   std::array<double, 3> offset{};
   if (!GetVec3(ctx, argv[1], offset)) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(
-      target->handle->Translate({offset[0], offset[1], offset[2]}));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("translate");
+  key.Add(target).Add(offset);
+  return DeferTransform(ctx, target, key,
+                        AffineMatrix({1, 0, 0}, {0, 1, 0}, {0, 0, 1},
+                                     {offset[0], offset[1], offset[2]}));
 }
 
 JSValue JsScale(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   if (argc < 2) {
     return JS_ThrowTypeError(ctx, "scale expects (manifold, factor)");
   }
-  JsManifold *target = GetJsManifold(ctx, argv[0]);
+  JsManifold *target = GetJsManifoldDeferred(ctx, argv[0]);
   if (!target) return JS_EXCEPTION;
   manifold::vec3 scaleVec{1.0, 1.0, 1.0};
   if (JS_IsNumber(argv[1])) {
@@ -567,36 +1389,43 @@ JSValue JsScale(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
     if (!GetVec3(ctx, argv[1], factors)) return JS_EXCEPTION;
     scaleVec = {factors[0], factors[1], factors[2]};
   }
-  auto manifold = std::make_shared<manifold::Manifold>(target->handle->Scale(scaleVec));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("scale");
+  key.Add(target).Add(scaleVec);
+  return DeferTransform(ctx, target, key,
+                        AffineMatrix({scaleVec.x, 0, 0}, {0, scaleVec.y, 0}, {0, 0, scaleVec.z}));
 }
 
 JSValue JsRotate(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   if (argc < 2) {
     return JS_ThrowTypeError(ctx, "rotate expects (manifold, [x,y,z] degrees)");
   }
-  JsManifold *target = GetJsManifold(ctx, argv[0]);
+  JsManifold *target = GetJsManifoldDeferred(ctx, argv[0]);
   if (!target) return JS_EXCEPTION;
   std::array<double, 3> angles{};
   if (!GetVec3(ctx, argv[1], angles)) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(
-      target->handle->Rotate(angles[0], angles[1], angles[2]));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("rotate");
+  key.Add(target).Add(angles);
+  // Same order as Manifold::Rotate: about x, then y, then z.
+  const double cx = CosDegrees(angles[0]), sx = SinDegrees(angles[0]);
+  const double cy = CosDegrees(angles[1]), sy = SinDegrees(angles[1]);
+  const double cz = CosDegrees(angles[2]), sz = SinDegrees(angles[2]);
+  const manifold::mat3x4 rx = AffineMatrix({1, 0, 0}, {0, cx, sx}, {0, -sx, cx});
+  const manifold::mat3x4 ry = AffineMatrix({cy, 0, -sy}, {0, 1, 0}, {sy, 0, cy});
+  const manifold::mat3x4 rz = AffineMatrix({cz, sz, 0}, {-sz, cz, 0}, {0, 0, 1});
+  return DeferTransform(ctx, target, key, ComposeAffine(rz, ComposeAffine(ry, rx)));
 }
 
 JSValue JsTetrahedron(JSContext *ctx, JSValueConst, int, JSValueConst *) {
-  auto manifold = std::make_shared<manifold::Manifold>(
-      manifold::Manifold::Tetrahedron());
-  return WrapManifold(ctx, std::move(manifold));
+  return Memoized(ctx, OpKey("tetrahedron"),
+                  []() { return manifold::Manifold::Tetrahedron(); });
 }
 
 JSValue JsCompose(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
-  std::vector<manifold::Manifold> parts;
-  if (!CollectManifoldArgs(ctx, argc, argv, parts)) return JS_EXCEPTION;
+  std::vector<std::shared_ptr<manifold::Manifold>> parts;
+  OpKey key("compose");
+  if (!CollectManifoldArgs(ctx, argc, argv, parts, key)) return JS_EXCEPTION;
   if (parts.empty()) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(
-      manifold::Manifold::Compose(parts));
-  return WrapManifold(ctx, std::move(manifold));
+  return Memoized(ctx, key, [&]() { return manifold::Manifold::Compose(ToManifolds(parts)); });
 }
 
 JSValue JsDecompose(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -605,34 +1434,52 @@ JSValue JsDecompose(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv)
   }
   JsManifold *target = GetJsManifold(ctx, argv[0]);
   if (!target) return JS_EXCEPTION;
-  auto manifolds = target->handle->Decompose();
-  return ManifoldVectorToJsArray(ctx, std::move(manifolds));
+  OpKey key("decompose");
+  key.Add(target);
+  uint64_t hash = 0;
+  auto manifolds = MemoizedResults(ctx, key, hash,
+                                   [&]() { return target->handle->Decompose(); });
+  return ManifoldVectorToJsArray(ctx, std::move(manifolds), hash);
 }
 
 JSValue JsMirror(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   if (argc < 2) {
     return JS_ThrowTypeError(ctx, "mirror expects (manifold, [x,y,z])");
   }
-  JsManifold *target = GetJsManifold(ctx, argv[0]);
+  JsManifold *target = GetJsManifoldDeferred(ctx, argv[0]);
   if (!target) return JS_EXCEPTION;
   std::array<double, 3> normal{};
   if (!GetVec3(ctx, argv[1], normal)) return JS_EXCEPTION;
   manifold::vec3 plane{normal[0], normal[1], normal[2]};
-  auto manifold = std::make_shared<manifold::Manifold>(
-      target->handle->Mirror(plane));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("mirror");
+  key.Add(target).Add(plane);
+  const double length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+  if (length == 0.0) {
+    // Manifold's own answer for a degenerate plane.
+    ResolvePending(ctx, *target);
+    return Memoized(ctx, key, [&]() { return target->handle->Mirror(plane); });
+  }
+  // Reflection I - 2nn^T about the unit normal.
+  const double n[3] = {plane.x / length, plane.y / length, plane.z / length};
+  manifold::mat3x4 reflect = AffineMatrix({1, 0, 0}, {0, 1, 0}, {0, 0, 1});
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 3; ++row) reflect[col][row] -= 2 * n[row] * n[col];
+  }
+  return DeferTransform(ctx, target, key, reflect);
 }
 
 JSValue JsTransform(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   if (argc < 2) {
     return JS_ThrowTypeError(ctx, "transform expects (manifold, mat3x4)");
   }
-  JsManifold *target = GetJsManifold(ctx, argv[0]);
+  JsManifold *target = GetJsManifoldDeferred(ctx, argv[0]);
   if (!target) return JS_EXCEPTION;
   manifold::mat3x4 matrix{};
   if (!GetMat3x4(ctx, argv[1], matrix)) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(target->handle->Transform(matrix));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("transform");
+  key.Add(target);
+  for (int col = 0; col < 4; ++col) key.Add(matrix[col]);
+  return DeferTransform(ctx, target, key, matrix);
 }
 
 JSValue JsSetTolerance(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -643,8 +1490,9 @@ JSValue JsSetTolerance(JSContext *ctx, JSValueConst, int argc, JSValueConst *arg
   if (!target) return JS_EXCEPTION;
   double tol = 0.0;
   if (JS_ToFloat64(ctx, &tol, argv[1]) < 0) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(target->handle->SetTolerance(tol));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("setTolerance");
+  key.Add(target).Add(tol);
+  return Memoized(ctx, key, [&]() { return target->handle->SetTolerance(tol); });
 }
 
 JSValue JsSimplify(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -657,8 +1505,9 @@ JSValue JsSimplify(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   if (argc >= 2 && !JS_IsUndefined(argv[1])) {
     if (JS_ToFloat64(ctx, &tol, argv[1]) < 0) return JS_EXCEPTION;
   }
-  auto manifold = std::make_shared<manifold::Manifold>(target->handle->Simplify(tol));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("simplify");
+  key.Add(target).Add(tol);
+  return Memoized(ctx, key, [&]() { return target->handle->Simplify(tol); });
 }
 
 JSValue JsRefine(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -669,8 +1518,10 @@ JSValue JsRefine(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   if (!target) return JS_EXCEPTION;
   int32_t iterations = 0;
   if (JS_ToInt32(ctx, &iterations, argv[1]) < 0) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(target->handle->Refine(iterations));
-  return WrapManifold(ctx, std::move(manifold));
+  if (IsPreview(ctx)) iterations = std::max(1, (iterations + 1) / 2);
+  OpKey key("refine");
+  key.Add(target).Add(static_cast<int64_t>(iterations)).Persist();
+  return Memoized(ctx, key, [&]() { return target->handle->Refine(iterations); });
 }
 
 JSValue JsRefineToLength(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -681,8 +1532,10 @@ JSValue JsRefineToLength(JSContext *ctx, JSValueConst, int argc, JSValueConst *a
   if (!target) return JS_EXCEPTION;
   double length = 0.0;
   if (JS_ToFloat64(ctx, &length, argv[1]) < 0) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(target->handle->RefineToLength(length));
-  return WrapManifold(ctx, std::move(manifold));
+  length = TessellationLength(ctx, length);
+  OpKey key("refineToLength");
+  key.Add(target).Add(length).Persist();
+  return Memoized(ctx, key, [&]() { return target->handle->RefineToLength(length); });
 }
 
 JSValue JsRefineToTolerance(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -693,17 +1546,18 @@ JSValue JsRefineToTolerance(JSContext *ctx, JSValueConst, int argc, JSValueConst
   if (!target) return JS_EXCEPTION;
   double tol = 0.0;
   if (JS_ToFloat64(ctx, &tol, argv[1]) < 0) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(target->handle->RefineToTolerance(tol));
-  return WrapManifold(ctx, std::move(manifold));
+  tol = TessellationLength(ctx, tol);
+  OpKey key("refineToTolerance");
+  key.Add(target).Add(tol).Persist();
+  return Memoized(ctx, key, [&]() { return target->handle->RefineToTolerance(tol); });
 }
 
 JSValue JsHull(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
-  std::vector<manifold::Manifold> parts;
-  if (!CollectManifoldArgs(ctx, argc, argv, parts)) return JS_EXCEPTION;
+  std::vector<std::shared_ptr<manifold::Manifold>> parts;
+  OpKey key("hull");
+  if (!CollectManifoldArgs(ctx, argc, argv, parts, key)) return JS_EXCEPTION;
   if (parts.empty()) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(
-      manifold::Manifold::Hull(parts));
-  return WrapManifold(ctx, std::move(manifold));
+  return Memoized(ctx, key, [&]() { return manifold::Manifold::Hull(ToManifolds(parts)); });
 }
 
 JSValue JsHullPoints(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -712,9 +1566,9 @@ JSValue JsHullPoints(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv)
   }
   std::vector<manifold::vec3> pts;
   if (!JsArrayToVec3List(ctx, argv[0], pts)) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(
-      manifold::Manifold::Hull(pts));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("hullPoints");
+  key.Add(pts);
+  return Memoized(ctx, key, [&]() { return manifold::Manifold::Hull(pts); });
 }
 
 JSValue JsTrimByPlane(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -728,9 +1582,9 @@ JSValue JsTrimByPlane(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv
   double offset = 0.0;
   if (JS_ToFloat64(ctx, &offset, argv[2]) < 0) return JS_EXCEPTION;
   manifold::vec3 n{normal[0], normal[1], normal[2]};
-  auto manifold = std::make_shared<manifold::Manifold>(
-      target->handle->TrimByPlane(n, offset));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("trimByPlane");
+  key.Add(target).Add(n).Add(offset);
+  return Memoized(ctx, key, [&]() { return target->handle->TrimByPlane(n, offset); });
 }
 
 JSValue JsSurfaceArea(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -828,7 +1682,7 @@ JSValue JsStatus(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   return JS_NewString(ctx, err);
 }
 
-JSValue JsSlice(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+JSValue SliceTo(JSContext *ctx, int argc, JSValueConst *argv, bool flat) {
   if (argc < 1) {
     return JS_ThrowTypeError(ctx, "slice expects (manifold, height?)");
   }
@@ -839,17 +1693,61 @@ JSValue JsSlice(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
     if (JS_ToFloat64(ctx, &height, argv[1]) < 0) return JS_EXCEPTION;
   }
   manifold::Polygons polys = target->handle->Slice(height);
-  return PolygonsToJs(ctx, polys);
+  return flat ? PolygonsToFlatJs(ctx, polys) : PolygonsToJs(ctx, polys);
 }
 
-JSValue JsProject(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+JSValue ProjectTo(JSContext *ctx, int argc, JSValueConst *argv, bool flat) {
   if (argc < 1) {
     return JS_ThrowTypeError(ctx, "project expects a manifold");
   }
   JsManifold *target = GetJsManifold(ctx, argv[0]);
   if (!target) return JS_EXCEPTION;
   manifold::Polygons polys = target->handle->Project();
-  return PolygonsToJs(ctx, polys);
+  return flat ? PolygonsToFlatJs(ctx, polys) : PolygonsToJs(ctx, polys);
+}
+
+JSValue JsSlice(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  return SliceTo(ctx, argc, argv, false);
+}
+
+JSValue JsSliceFlat(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  return SliceTo(ctx, argc, argv, true);
+}
+
+JSValue JsProject(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  return ProjectTo(ctx, argc, argv, false);
+}
+
+JSValue JsProjectFlat(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  return ProjectTo(ctx, argc, argv, true);
+}
+
+// {numProp, vertProperties: Float32Array, triVerts: Uint32Array} from
+// GetMeshGL(), both views over one buffer.
+JSValue JsMeshData(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  if (argc < 1) {
+    return JS_ThrowTypeError(ctx, "meshData expects a manifold");
+  }
+  JsManifold *target = GetJsManifold(ctx, argv[0]);
+  if (!target) return JS_EXCEPTION;
+  const manifold::MeshGL mesh = target->handle->GetMeshGL();
+  const size_t propBytes = mesh.vertProperties.size() * sizeof(float);
+  const size_t triBytes = mesh.triVerts.size() * sizeof(uint32_t);
+  uint8_t *data = nullptr;
+  JSValue buffer = NewArrayBuffer(ctx, propBytes + triBytes, data);
+  if (JS_IsException(buffer)) return buffer;
+  if (propBytes) std::memcpy(data, mesh.vertProperties.data(), propBytes);
+  if (triBytes) std::memcpy(data + propBytes, mesh.triVerts.data(), triBytes);
+  JSValue obj = JS_NewObject(ctx);
+  JS_SetPropertyStr(ctx, obj, "numProp", JS_NewUint32(ctx, mesh.numProp));
+  JS_SetPropertyStr(ctx, obj, "vertProperties",
+                    NewTypedArrayView(ctx, buffer, 0, mesh.vertProperties.size(),
+                                      JS_TYPED_ARRAY_FLOAT32));
+  JS_SetPropertyStr(ctx, obj, "triVerts",
+                    NewTypedArrayView(ctx, buffer, propBytes, mesh.triVerts.size(),
+                                      JS_TYPED_ARRAY_UINT32));
+  JS_FreeValue(ctx, buffer);
+  return obj;
 }
 
 JSValue JsExtrude(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -914,9 +1812,11 @@ JSValue JsExtrude(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   }
   JS_FreeValue(ctx, scaleVal);
 
-  auto manifold = std::make_shared<manifold::Manifold>(
-      manifold::Manifold::Extrude(polys, height, divisions, twist, scaleTop));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("extrude");
+  key.Add(polys).Add(height).Add(static_cast<int64_t>(divisions)).Add(twist).Add(scaleTop);
+  return Memoized(ctx, key, [&]() {
+    return manifold::Manifold::Extrude(polys, height, divisions, twist, scaleTop);
+  });
 }
 
 JSValue JsRevolve(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -946,45 +1846,91 @@ JSValue JsRevolve(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
     }
     JS_FreeValue(ctx, degVal);
   }
-  auto manifold = std::make_shared<manifold::Manifold>(
-      manifold::Manifold::Revolve(polys, segments, degrees));
-  return WrapManifold(ctx, std::move(manifold));
+  double maxRadius = 0.0;
+  for (const auto &loop : polys) {
+    for (const auto &pt : loop) maxRadius = std::max(maxRadius, std::abs(pt.x));
+  }
+  segments = CircularSegments(ctx, maxRadius, segments);
+  OpKey key("revolve");
+  key.Add(polys).Add(static_cast<int64_t>(segments)).Add(degrees);
+  return Memoized(ctx, key, [&]() {
+    return manifold::Manifold::Revolve(polys, segments, degrees);
+  });
 }
 
+// batchBoolean results are persisted from this many inputs; smaller ones
+// recompute faster than a cache file is written. Counting inputs rather than
+// triangles keeps the inputs unevaluated until the op runs.
+constexpr size_t kPersistBatchInputs = 32;
+
 JSValue JsBatchBoolean(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   if (argc < 2) {
     return JS_ThrowTypeError(ctx, "batchBoolean expects (op, manifolds)");
   }
   manifold::OpType op;
   if (!GetOpType(ctx, argv[0], op)) return JS_EXCEPTION;
-  std::vector<manifold::Manifold> parts;
+  std::vector<std::shared_ptr<manifold::Manifold>> parts;
+  OpKey key("batchBoolean");
+  key.Add(static_cast<int64_t>(op));
   if (JS_IsArray(argv[1])) {
-    if (!CollectManifoldArgs(ctx, 1, &argv[1], parts)) return JS_EXCEPTION;
+    if (!CollectManifoldArgs(ctx, 1, &argv[1], parts, key)) return JS_EXCEPTION;
   } else {
-    if (!CollectManifoldArgs(ctx, argc - 1, argv + 1, parts)) return JS_EXCEPTION;
+    if (!CollectManifoldArgs(ctx, argc - 1, argv + 1, parts, key)) return JS_EXCEPTION;
   }
   if (parts.empty()) {
     JS_ThrowTypeError(ctx, "batchBoolean requires manifolds");
     return JS_EXCEPTION;
   }
-  auto manifold = std::make_shared<manifold::Manifold>(
-      manifold::Manifold::BatchBoolean(parts, op));
-  return WrapManifold(ctx, std::move(manifold));
+  if (parts.size() >= kPersistBatchInputs) key.Persist();
+  return Memoized(ctx, key, [&]() {
+    return manifold::Manifold::BatchBoolean(ToManifolds(parts), op);
+  });
 }
 
 JSValue JsBooleanOp(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   if (argc < 3) {
     return JS_ThrowTypeError(ctx, "boolean expects (manifoldA, manifoldB, op)");
   }
-  JsManifold *base = GetJsManifold(ctx, argv[0]);
-  if (!base) return JS_EXCEPTION;
-  JsManifold *other = GetJsManifold(ctx, argv[1]);
-  if (!other) return JS_EXCEPTION;
+  if (!GetJsManifoldDeferred(ctx, argv[0]) || !GetJsManifoldDeferred(ctx, argv[1])) {
+    return JS_EXCEPTION;
+  }
   manifold::OpType op;
   if (!GetOpType(ctx, argv[2], op)) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(
-      base->handle->Boolean(*other->handle, op));
-  return WrapManifold(ctx, std::move(manifold));
+  JSValueConst operands[2] = {argv[0], argv[1]};
+  return JsBoolean(ctx, 2, operands, op);
+}
+
+// cached(key, fn): fn() is called only when no result for `key` is cached in
+// memory or on disk. The key stands in for everything fn depends on, so the
+// script must change it whenever fn would build something else.
+JSValue JsCached(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  if (argc < 2 || !JS_IsFunction(ctx, argv[1])) {
+    return JS_ThrowTypeError(ctx, "cached expects (key, () => manifold)");
+  }
+  const char *keyStr = JS_ToCString(ctx, argv[0]);
+  if (!keyStr) return JS_EXCEPTION;
+  OpKey key("cached");
+  key.Add(std::string(keyStr)).Persist();
+  JS_FreeCString(ctx, keyStr);
+
+  struct CallbackFailed {};
+  try {
+    return Memoized(ctx, key, [&]() {
+      JSValue result = JS_Call(ctx, argv[1], JS_UNDEFINED, 0, nullptr);
+      if (JS_IsException(result)) throw CallbackFailed{};
+      auto *wrapper = static_cast<JsManifold *>(JS_GetOpaque(result, g_manifoldClassId));
+      if (wrapper) ResolvePending(ctx, *wrapper);
+      std::shared_ptr<manifold::Manifold> handle = wrapper ? wrapper->handle : nullptr;
+      JS_FreeValue(ctx, result);
+      if (!handle) {
+        JS_ThrowTypeError(ctx, "cached callback must return a manifold");
+        throw CallbackFailed{};
+      }
+      return *handle;
+    });
+  } catch (const CallbackFailed &) {
+    return JS_EXCEPTION;
+  }
 }
 
 JSValue JsLoadMesh(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -1050,16 +1996,50 @@ JSValue JsLoadMesh(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   // Mesh import is not available in web builds (MANIFOLD_EXPORT is disabled)
   return JS_ThrowInternalError(ctx, "loadMesh is not available in web builds. Mesh file loading requires MANIFOLD_EXPORT which is disabled for web.");
 #else
+  // Key on the file's identity as well as its path so an edited mesh is
+  // re-imported while an untouched one comes straight from the cache.
+  // Without both there is no sound key, so fail rather than cache under one.
+  std::error_code sizeErr;
+  std::error_code timeErr;
+  const auto fileSize = std::filesystem::file_size(fsPath, sizeErr);
+  const auto fileTime = std::filesystem::last_write_time(fsPath, timeErr);
+  if (sizeErr || timeErr) {
+    const std::string reason = (sizeErr ? sizeErr : timeErr).message();
+    PrintLoadMeshError("loadMesh: cannot stat '" + resolvedPath + "': " + reason);
+    return JS_ThrowInternalError(ctx, "loadMesh: cannot stat '%s': %s", resolvedPath.c_str(),
+                                 reason.c_str());
+  }
+  OpKey key("loadMesh");
+  key.Add(resolvedPath)
+      .Add(static_cast<int64_t>(fileSize))
+      .Add(static_cast<int64_t>(fileTime.time_since_epoch().count()))
+      .Add(forceCleanup)
+      .Persist()
+      .QualityIndependent();
+  struct EmptyMeshError {};
   try {
-    manifold::MeshGL mesh = manifold::ImportMesh(fsPath.string(), forceCleanup);
-    if (mesh.NumTri() == 0 || mesh.NumVert() == 0) {
-      const std::string msg = "loadMesh: imported mesh is empty for '" + resolvedPath + "'";
-      PrintLoadMeshError(msg);
-      return JS_ThrowInternalError(ctx, "loadMesh: imported mesh is empty");
-    }
-    manifold::Manifold manifold(mesh);
-    auto handle = std::make_shared<manifold::Manifold>(std::move(manifold));
-    return WrapManifold(ctx, std::move(handle));
+    return Memoized(ctx, key, [&]() {
+      manifold::MeshGL mesh;
+      // Binary STL and PLY are mapped and welded natively; everything else
+      // goes through assimp.
+      std::string readError;
+      switch (ReadMeshFast(fsPath, mesh, readError)) {
+        case MeshReadStatus::Ok:
+          if (forceCleanup) mesh.Merge();
+          break;
+        case MeshReadStatus::Unsupported:
+          mesh = manifold::ImportMesh(fsPath.string(), forceCleanup);
+          break;
+        case MeshReadStatus::Error:
+          throw std::runtime_error(readError);
+      }
+      if (mesh.NumTri() == 0 || mesh.NumVert() == 0) throw EmptyMeshError{};
+      return manifold::Manifold(mesh);
+    });
+  } catch (const EmptyMeshError &) {
+    const std::string msg = "loadMesh: imported mesh is empty for '" + resolvedPath + "'";
+    PrintLoadMeshError(msg);
+    return JS_ThrowInternalError(ctx, "loadMesh: imported mesh is empty");
   } catch (const std::exception &e) {
     const std::string msg = std::string("loadMesh failed: ") + e.what();
     PrintLoadMeshError(msg);
@@ -1068,8 +2048,323 @@ JSValue JsLoadMesh(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
 #endif
 }
 
+JSValue WrapSdf(JSContext *ctx, SdfNodePtr node) {
+  JSValue obj = JS_NewObjectClass(ctx, g_sdfClassId);
+  if (JS_IsException(obj)) return obj;
+  JS_SetOpaque(obj, new JsSdf{std::move(node)});
+  return obj;
+}
 
+SdfNodePtr GetSdfNode(JSContext *ctx, JSValueConst value) {
+  auto *wrapper = static_cast<JsSdf *>(JS_GetOpaque2(ctx, value, g_sdfClassId));
+  return wrapper ? wrapper->node : nullptr;
+}
 
+bool GetSdfNumber(JSContext *ctx, int argc, JSValueConst *argv, int index,
+                  const char *usage, double &out) {
+  if (index >= argc || JS_IsUndefined(argv[index])) {
+    JS_ThrowTypeError(ctx, "%s", usage);
+    return false;
+  }
+  return JS_ToFloat64(ctx, &out, argv[index]) == 0;
+}
+
+// Children of an n-ary sdf op: `...nodes` or a single array of nodes.
+bool CollectSdfArgs(JSContext *ctx, int argc, JSValueConst *argv,
+                    std::vector<SdfNodePtr> &out) {
+  auto add = [&](JSValueConst value) {
+    SdfNodePtr node = GetSdfNode(ctx, value);
+    if (node) out.push_back(std::move(node));
+    return node != nullptr;
+  };
+  if (argc == 1 && JS_IsArray(argv[0])) {
+    JSValue lengthVal = JS_GetPropertyStr(ctx, argv[0], "length");
+    uint32_t len = 0;
+    if (JS_ToUint32(ctx, &len, lengthVal) < 0) {
+      JS_FreeValue(ctx, lengthVal);
+      return false;
+    }
+    JS_FreeValue(ctx, lengthVal);
+    for (uint32_t i = 0; i < len; ++i) {
+      JSValue itemVal = JS_GetPropertyUint32(ctx, argv[0], i);
+      const bool ok = add(itemVal);
+      JS_FreeValue(ctx, itemVal);
+      if (!ok) return false;
+    }
+  } else {
+    for (int i = 0; i < argc; ++i) {
+      if (!add(argv[i])) return false;
+    }
+  }
+  if (out.empty()) {
+    JS_ThrowTypeError(ctx, "expected at least one sdf expression");
+    return false;
+  }
+  return true;
+}
+
+JSValue JsSdfSphere(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  double radius = 0.0;
+  if (!GetSdfNumber(ctx, argc, argv, 0, "sdf.sphere expects (radius)", radius)) {
+    return JS_EXCEPTION;
+  }
+  return WrapSdf(ctx, MakeSdfNode(SdfOp::Sphere, {radius}));
+}
+
+JSValue JsSdfBox(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  if (argc < 1) return JS_ThrowTypeError(ctx, "sdf.box expects (size|[x,y,z])");
+  std::array<double, 3> size{};
+  if (JS_IsNumber(argv[0])) {
+    if (JS_ToFloat64(ctx, &size[0], argv[0]) < 0) return JS_EXCEPTION;
+    size[1] = size[2] = size[0];
+  } else if (!GetVec3(ctx, argv[0], size)) {
+    return JS_EXCEPTION;
+  }
+  return WrapSdf(ctx, MakeSdfNode(SdfOp::Box, {size[0] / 2, size[1] / 2, size[2] / 2}));
+}
+
+JSValue JsSdfCylinder(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  const char *usage = "sdf.cylinder expects (radius, height)";
+  double radius = 0.0;
+  double height = 0.0;
+  if (!GetSdfNumber(ctx, argc, argv, 0, usage, radius) ||
+      !GetSdfNumber(ctx, argc, argv, 1, usage, height)) {
+    return JS_EXCEPTION;
+  }
+  return WrapSdf(ctx, MakeSdfNode(SdfOp::Cylinder, {radius, height / 2}));
+}
+
+JSValue JsSdfTorus(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  const char *usage = "sdf.torus expects (majorRadius, minorRadius)";
+  double major = 0.0;
+  double minor = 0.0;
+  if (!GetSdfNumber(ctx, argc, argv, 0, usage, major) ||
+      !GetSdfNumber(ctx, argc, argv, 1, usage, minor)) {
+    return JS_EXCEPTION;
+  }
+  return WrapSdf(ctx, MakeSdfNode(SdfOp::Torus, {major, minor}));
+}
+
+JSValue JsSdfPlane(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  if (argc < 1) return JS_ThrowTypeError(ctx, "sdf.plane expects ([nx,ny,nz], offset?)");
+  std::array<double, 3> normal{};
+  if (!GetVec3(ctx, argv[0], normal)) return JS_EXCEPTION;
+  double offset = 0.0;
+  if (argc >= 2 && !JS_IsUndefined(argv[1]) && JS_ToFloat64(ctx, &offset, argv[1]) < 0) {
+    return JS_EXCEPTION;
+  }
+  const double len = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] +
+                               normal[2] * normal[2]);
+  if (len <= 0.0) return JS_ThrowRangeError(ctx, "sdf.plane normal must be non-zero");
+  return WrapSdf(ctx, MakeSdfNode(SdfOp::Plane, {normal[0] / len, normal[1] / len,
+                                                 normal[2] / len, offset}));
+}
+
+JSValue JsSdfGyroid(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  const char *usage = "sdf.gyroid expects (period, thickness)";
+  double period = 0.0;
+  double thickness = 0.0;
+  if (!GetSdfNumber(ctx, argc, argv, 0, usage, period) ||
+      !GetSdfNumber(ctx, argc, argv, 1, usage, thickness)) {
+    return JS_EXCEPTION;
+  }
+  if (period <= 0.0) return JS_ThrowRangeError(ctx, "sdf.gyroid period must be positive");
+  return WrapSdf(ctx, MakeSdfNode(SdfOp::Gyroid, {2 * manifold::kPi / period, thickness / 2}));
+}
+
+JSValue SdfCombine(JSContext *ctx, int argc, JSValueConst *argv, SdfOp op) {
+  std::vector<SdfNodePtr> children;
+  if (!CollectSdfArgs(ctx, argc, argv, children)) return JS_EXCEPTION;
+  if (children.size() == 1) return WrapSdf(ctx, std::move(children.front()));
+  return WrapSdf(ctx, MakeSdfNode(op, {}, std::move(children)));
+}
+
+JSValue JsSdfUnion(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  return SdfCombine(ctx, argc, argv, SdfOp::Union);
+}
+
+JSValue JsSdfIntersection(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  return SdfCombine(ctx, argc, argv, SdfOp::Intersection);
+}
+
+JSValue JsSdfDifference(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  return SdfCombine(ctx, argc, argv, SdfOp::Difference);
+}
+
+// smooth*(a, b, radius)
+JSValue SdfSmoothCombine(JSContext *ctx, int argc, JSValueConst *argv, SdfOp op,
+                         const char *usage) {
+  if (argc < 3) return JS_ThrowTypeError(ctx, "%s", usage);
+  SdfNodePtr a = GetSdfNode(ctx, argv[0]);
+  if (!a) return JS_EXCEPTION;
+  SdfNodePtr b = GetSdfNode(ctx, argv[1]);
+  if (!b) return JS_EXCEPTION;
+  double radius = 0.0;
+  if (JS_ToFloat64(ctx, &radius, argv[2]) < 0) return JS_EXCEPTION;
+  return WrapSdf(ctx, MakeSdfNode(op, {radius}, {std::move(a), std::move(b)}));
+}
+
+JSValue JsSdfSmoothUnion(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  return SdfSmoothCombine(ctx, argc, argv, SdfOp::SmoothUnion,
+                          "sdf.smoothUnion expects (a, b, radius)");
+}
+
+JSValue JsSdfSmoothIntersection(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  return SdfSmoothCombine(ctx, argc, argv, SdfOp::SmoothIntersection,
+                          "sdf.smoothIntersection expects (a, b, radius)");
+}
+
+JSValue JsSdfSmoothDifference(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  return SdfSmoothCombine(ctx, argc, argv, SdfOp::SmoothDifference,
+                          "sdf.smoothDifference expects (a, b, radius)");
+}
+
+JSValue JsSdfTranslate(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  if (argc < 2) return JS_ThrowTypeError(ctx, "sdf.translate expects (sdf, [x,y,z])");
+  SdfNodePtr child = GetSdfNode(ctx, argv[0]);
+  if (!child) return JS_EXCEPTION;
+  std::array<double, 3> offset{};
+  if (!GetVec3(ctx, argv[1], offset)) return JS_EXCEPTION;
+  return WrapSdf(ctx, MakeSdfNode(SdfOp::Translate, {offset[0], offset[1], offset[2]},
+                                  {std::move(child)}));
+}
+
+// Same convention as rotate(): degrees about X, then Y, then Z.
+JSValue JsSdfRotate(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  if (argc < 2) return JS_ThrowTypeError(ctx, "sdf.rotate expects (sdf, [rx,ry,rz])");
+  SdfNodePtr child = GetSdfNode(ctx, argv[0]);
+  if (!child) return JS_EXCEPTION;
+  std::array<double, 3> angles{};
+  if (!GetVec3(ctx, argv[1], angles)) return JS_EXCEPTION;
+  const double cx = CosDegrees(angles[0]), sx = SinDegrees(angles[0]);
+  const double cy = CosDegrees(angles[1]), sy = SinDegrees(angles[1]);
+  const double cz = CosDegrees(angles[2]), sz = SinDegrees(angles[2]);
+  // Rows of (Rz * Ry * Rx)^T, which maps world points back into the child.
+  std::vector<double> inverse = {
+      cz * cy,                cy * sz,                -sy,
+      cz * sy * sx - sz * cx, sz * sy * sx + cz * cx, cy * sx,
+      cz * sy * cx + sz * sx, sz * sy * cx - cz * sx, cy * cx,
+  };
+  return WrapSdf(ctx, MakeSdfNode(SdfOp::Rotate, std::move(inverse), {std::move(child)}));
+}
+
+JSValue JsSdfScale(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  if (argc < 2) return JS_ThrowTypeError(ctx, "sdf.scale expects (sdf, factor)");
+  SdfNodePtr child = GetSdfNode(ctx, argv[0]);
+  if (!child) return JS_EXCEPTION;
+  double factor = 1.0;
+  if (JS_ToFloat64(ctx, &factor, argv[1]) < 0) return JS_EXCEPTION;
+  if (factor <= 0.0) return JS_ThrowRangeError(ctx, "sdf.scale factor must be positive");
+  return WrapSdf(ctx, MakeSdfNode(SdfOp::Scale, {factor}, {std::move(child)}));
+}
+
+JSValue SdfModify(JSContext *ctx, int argc, JSValueConst *argv, SdfOp op, bool halve,
+                  const char *usage) {
+  if (argc < 2) return JS_ThrowTypeError(ctx, "%s", usage);
+  SdfNodePtr child = GetSdfNode(ctx, argv[0]);
+  if (!child) return JS_EXCEPTION;
+  double amount = 0.0;
+  if (JS_ToFloat64(ctx, &amount, argv[1]) < 0) return JS_EXCEPTION;
+  return WrapSdf(ctx, MakeSdfNode(op, {halve ? amount / 2 : amount}, {std::move(child)}));
+}
+
+JSValue JsSdfShell(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  return SdfModify(ctx, argc, argv, SdfOp::Shell, true, "sdf.shell expects (sdf, thickness)");
+}
+
+JSValue JsSdfOffset(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
+  return SdfModify(ctx, argc, argv, SdfOp::Offset, false, "sdf.offset expects (sdf, distance)");
+}
+
+// Samples sdfBatch(points, out) on a regular grid, one block of points per
+// call through shared Float64Arrays, then meshes the interpolated samples.
+JSValue LevelSetBatched(JSContext *ctx, JSValueConst opts, JSValueConst sdfBatch,
+                        const manifold::Box &bounds, double edgeLength, double level,
+                        double tolerance, bool canParallel) {
+  double spacing = edgeLength;
+  JSValue spacingVal = JS_GetPropertyStr(ctx, opts, "sampleSpacing");
+  if (!JS_IsUndefined(spacingVal) && JS_ToFloat64(ctx, &spacing, spacingVal) < 0) {
+    JS_FreeValue(ctx, spacingVal);
+    return JS_EXCEPTION;
+  }
+  JS_FreeValue(ctx, spacingVal);
+  int32_t batchSize = 4096;
+  JSValue batchVal = JS_GetPropertyStr(ctx, opts, "batchSize");
+  if (!JS_IsUndefined(batchVal) && JS_ToInt32(ctx, &batchSize, batchVal) < 0) {
+    JS_FreeValue(ctx, batchVal);
+    return JS_EXCEPTION;
+  }
+  JS_FreeValue(ctx, batchVal);
+  if (!(spacing > 0.0) || batchSize < 1) {
+    return JS_ThrowRangeError(ctx, "levelSet sampleSpacing and batchSize must be positive");
+  }
+  if (SdfGrid::CountPoints(bounds, spacing) > (size_t{1} << 28)) {
+    return JS_ThrowRangeError(ctx, "levelSet sampleSpacing is too fine for these bounds");
+  }
+
+  SdfGrid grid(bounds, spacing);
+  const size_t block = std::min<size_t>(batchSize, grid.NumPoints());
+  const size_t outOffset = block * 3 * sizeof(double);
+  uint8_t *data = nullptr;
+  JSValue buffer = NewArrayBuffer(ctx, outOffset + block * sizeof(double), data);
+  if (JS_IsException(buffer)) return buffer;
+  JSValue points = NewTypedArrayView(ctx, buffer, 0, block * 3, JS_TYPED_ARRAY_FLOAT64);
+  JSValue out = NewTypedArrayView(ctx, buffer, outOffset, block, JS_TYPED_ARRAY_FLOAT64);
+
+  bool ok = !JS_IsException(points) && !JS_IsException(out);
+  for (size_t start = 0; ok && start < grid.NumPoints(); start += block) {
+    const size_t count = std::min(block, grid.NumPoints() - start);
+    if (count < block) {
+      // Shorter views for the final block so JS sees exactly `count` points.
+      JS_FreeValue(ctx, points);
+      JS_FreeValue(ctx, out);
+      points = NewTypedArrayView(ctx, buffer, 0, count * 3, JS_TYPED_ARRAY_FLOAT64);
+      out = NewTypedArrayView(ctx, buffer, outOffset, count, JS_TYPED_ARRAY_FLOAT64);
+      if (JS_IsException(points) || JS_IsException(out)) {
+        ok = false;
+        break;
+      }
+    }
+    // Re-fetched every block: the callback could have detached the buffer.
+    size_t size = 0;
+    uint8_t *bytes = JS_GetArrayBuffer(ctx, &size, buffer);
+    if (!bytes) {
+      ok = false;
+      break;
+    }
+    auto *coords = reinterpret_cast<double *>(bytes);
+    for (size_t i = 0; i < count; ++i) {
+      const manifold::vec3 p = grid.Point(start + i);
+      coords[3 * i] = p.x;
+      coords[3 * i + 1] = p.y;
+      coords[3 * i + 2] = p.z;
+    }
+    JSValueConst args[2] = {points, out};
+    JSValue result = JS_Call(ctx, sdfBatch, JS_UNDEFINED, 2, args);
+    if (JS_IsException(result)) {
+      ok = false;
+      break;
+    }
+    JS_FreeValue(ctx, result);
+    bytes = JS_GetArrayBuffer(ctx, &size, buffer);
+    if (!bytes) {
+      ok = false;
+      break;
+    }
+    const auto *values = reinterpret_cast<const double *>(bytes + outOffset);
+    for (size_t i = 0; i < count; ++i) grid.Set(start + i, values[i]);
+  }
+  JS_FreeValue(ctx, points);
+  JS_FreeValue(ctx, out);
+  JS_FreeValue(ctx, buffer);
+  if (!ok) return JS_EXCEPTION;
+
+  auto manifoldPtr = std::make_shared<manifold::Manifold>(manifold::Manifold::LevelSet(
+      [&grid](manifold::vec3 p) { return grid.Evaluate(p); }, bounds, edgeLength, level,
+      tolerance, canParallel));
+  // Like `sdf` callbacks, the batch function is opaque to the op graph.
+  return WrapManifold(ctx, std::move(manifoldPtr), NextVolatileHash());
+}
 
 JSValue JsLevelSet(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   if (argc < 1 || !JS_IsObject(argv[0])) {
@@ -1077,9 +2372,14 @@ JSValue JsLevelSet(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   }
   JSValue opts = argv[0];
   JSValue sdfVal = JS_GetPropertyStr(ctx, opts, "sdf");
-  if (!JS_IsFunction(ctx, sdfVal)) {
+  const bool batched = JS_IsUndefined(sdfVal);
+  if (batched) sdfVal = JS_GetPropertyStr(ctx, opts, "sdfBatch");
+  auto *nativeSdf =
+      batched ? nullptr : static_cast<JsSdf *>(JS_GetOpaque(sdfVal, g_sdfClassId));
+  if (!nativeSdf && !JS_IsFunction(ctx, sdfVal)) {
     JS_FreeValue(ctx, sdfVal);
-    return JS_ThrowTypeError(ctx, "levelSet requires sdf function");
+    return JS_ThrowTypeError(
+        ctx, "levelSet requires sdf (function or sdf expression) or sdfBatch function");
   }
   JSValue boundsVal = JS_GetPropertyStr(ctx, opts, "bounds");
   if (JS_IsUndefined(boundsVal)) {
@@ -1106,10 +2406,13 @@ JSValue JsLevelSet(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
     return JS_EXCEPTION;
   }
   JS_FreeValue(ctx, edgeVal);
+  edgeLength = TessellationLength(ctx, edgeLength);
 
   double level = 0.0;
   double tolerance = -1.0;
-  bool canParallel = false;
+  // Native expressions and batch samples are thread-safe; per-point JS
+  // callbacks must stay on this thread.
+  bool canParallel = nativeSdf != nullptr || batched;
 
   JSValue levelVal = JS_GetPropertyStr(ctx, opts, "level");
   if (!JS_IsUndefined(levelVal)) {
@@ -1143,6 +2446,32 @@ JSValue JsLevelSet(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   }
   JS_FreeValue(ctx, parallelVal);
 
+  if (nativeSdf) {
+    SdfNodePtr node = nativeSdf->node;
+    JS_FreeValue(ctx, sdfVal);
+    SdfProgram program;
+    if (!program.Compile(*node)) {
+      return JS_ThrowRangeError(ctx, "sdf expression nests deeper than %d levels",
+                                static_cast<int>(SdfProgram::kMaxDepth));
+    }
+    OpKey key("levelSet");
+    // Compile has bounded the depth of the recursive Add.
+    key.Add(*node).Add(bounds.min).Add(bounds.max)
+        .Add(edgeLength).Add(level).Add(tolerance).Add(canParallel).Persist();
+    return Memoized(ctx, key, [&]() {
+      return manifold::Manifold::LevelSet(
+          [&program](manifold::vec3 p) { return program.Evaluate(p); }, bounds,
+          edgeLength, level, tolerance, canParallel);
+    });
+  }
+
+  if (batched) {
+    JSValue result = LevelSetBatched(ctx, opts, sdfVal, bounds, edgeLength, level,
+                                     tolerance, canParallel);
+    JS_FreeValue(ctx, sdfVal);
+    return result;
+  }
+
   if (canParallel) {
     JS_FreeValue(ctx, sdfVal);
     return JS_ThrowTypeError(ctx,
@@ -1192,7 +2521,8 @@ JSValue JsLevelSet(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   if (errorOccurred) {
     return JS_ThrowInternalError(ctx, "%s", errorMessage.c_str());
   }
-  return WrapManifold(ctx, std::move(manifoldPtr));
+  // The SDF is an opaque JS closure, so the result cannot be keyed.
+  return WrapManifold(ctx, std::move(manifoldPtr), NextVolatileHash());
 }
 
 JSValue JsAsOriginal(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -1201,8 +2531,9 @@ JSValue JsAsOriginal(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv)
   }
   JsManifold *target = GetJsManifold(ctx, argv[0]);
   if (!target) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(target->handle->AsOriginal());
-  return WrapManifold(ctx, std::move(manifold));
+  auto manifoldPtr = std::make_shared<manifold::Manifold>(target->handle->AsOriginal());
+  // Every call reserves a new original ID, so equal calls must not share one.
+  return WrapManifold(ctx, std::move(manifoldPtr), NextVolatileHash());
 }
 
 JSValue JsOriginalId(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -1254,9 +2585,11 @@ JSValue JsCalculateNormals(JSContext *ctx, JSValueConst, int argc, JSValueConst
   if (argc >= 3 && !JS_IsUndefined(argv[2])) {
     if (JS_ToFloat64(ctx, &minSharp, argv[2]) < 0) return JS_EXCEPTION;
   }
-  auto manifold = std::make_shared<manifold::Manifold>(
-      target->handle->CalculateNormals(normalIdx, minSharp));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("calculateNormals");
+  key.Add(target).Add(static_cast<int64_t>(normalIdx)).Add(minSharp);
+  return Memoized(ctx, key, [&]() {
+    return target->handle->CalculateNormals(normalIdx, minSharp);
+  });
 }
 
 JSValue JsCalculateCurvature(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -1269,9 +2602,11 @@ JSValue JsCalculateCurvature(JSContext *ctx, JSValueConst, int argc, JSValueCons
   int32_t meanIdx = 0;
   if (JS_ToInt32(ctx, &gaussianIdx, argv[1]) < 0) return JS_EXCEPTION;
   if (JS_ToInt32(ctx, &meanIdx, argv[2]) < 0) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(
-      target->handle->CalculateCurvature(gaussianIdx, meanIdx));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("calculateCurvature");
+  key.Add(target).Add(static_cast<int64_t>(gaussianIdx)).Add(static_cast<int64_t>(meanIdx));
+  return Memoized(ctx, key, [&]() {
+    return target->handle->CalculateCurvature(gaussianIdx, meanIdx);
+  });
 }
 
 JSValue JsSmoothByNormals(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -1282,9 +2617,9 @@ JSValue JsSmoothByNormals(JSContext *ctx, JSValueConst, int argc, JSValueConst *
   if (!target) return JS_EXCEPTION;
   int32_t normalIdx = 0;
   if (JS_ToInt32(ctx, &normalIdx, argv[1]) < 0) return JS_EXCEPTION;
-  auto manifold = std::make_shared<manifold::Manifold>(
-      target->handle->SmoothByNormals(normalIdx));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("smoothByNormals");
+  key.Add(target).Add(static_cast<int64_t>(normalIdx));
+  return Memoized(ctx, key, [&]() { return target->handle->SmoothByNormals(normalIdx); });
 }
 
 JSValue JsSmoothOut(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -1301,9 +2636,9 @@ JSValue JsSmoothOut(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv)
   if (argc >= 3 && !JS_IsUndefined(argv[2])) {
     if (JS_ToFloat64(ctx, &minSmooth, argv[2]) < 0) return JS_EXCEPTION;
   }
-  auto manifold = std::make_shared<manifold::Manifold>(
-      target->handle->SmoothOut(minSharp, minSmooth));
-  return WrapManifold(ctx, std::move(manifold));
+  OpKey key("smoothOut");
+  key.Add(target).Add(minSharp).Add(minSmooth).Persist();
+  return Memoized(ctx, key, [&]() { return target->handle->SmoothOut(minSharp, minSmooth); });
 }
 
 JSValue JsMinGap(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
@@ -1319,6 +2654,48 @@ JSValue JsMinGap(JSContext *ctx, JSValueConst, int argc, JSValueConst *argv) {
   return JS_NewFloat64(ctx, a->handle->MinGap(*b->handle, searchLength));
 }
 
+// Evaluates the lazy CSG under `roots` level by level through the op graph
+// recorded in the geometry cache. A node's level is one more than its
+// deepest input, so everything on a level is independent and the level is
+// evaluated concurrently. Separate parts of a scene then build on separate
+// cores instead of one after another, each still parallel inside Manifold.
+// Nodes missing from the cache (volatile results) are evaluated with their
+// parent.
+void EvaluateInParallel(JSContext *ctx, const std::vector<uint64_t> &roots) {
+  GeometryCache *cache = GetGeometryCache(ctx);
+  if (!cache) return;
+  // Nodes are numbered in post-order, so every input precedes its consumers.
+  std::unordered_map<uint64_t, size_t> index;
+  std::vector<const GeometryCache::Entry *> nodes;
+  std::vector<std::vector<size_t>> dependents;
+  // Iterative post-order walk; each frame is a node and its next input.
+  std::vector<std::pair<uint64_t, size_t>> stack;
+  for (uint64_t root : roots) {
+    if (!index.count(root) && cache->entries.count(root)) stack.emplace_back(root, 0);
+    while (!stack.empty()) {
+      const uint64_t hash = stack.back().first;
+      const GeometryCache::Entry &entry = cache->entries.at(hash);
+      if (stack.back().second < entry.inputs.size()) {
+        const uint64_t input = entry.inputs[stack.back().second++];
+        if (!index.count(input) && cache->entries.count(input)) stack.emplace_back(input, 0);
+        continue;
+      }
+      const size_t node = nodes.size();
+      for (uint64_t input : entry.inputs) {
+        auto it = index.find(input);
+        if (it != index.end()) dependents[it->second].push_back(node);
+      }
+      index[hash] = node;
+      nodes.push_back(&entry);
+      dependents.emplace_back();
+      stack.pop_back();
+    }
+  }
+  ParallelGraph(dependents, [&](size_t node) {
+    for (const auto &result : nodes[node]->results) result->Status();
+  });
+}
+
 void RegisterBindingsInternal(JSContext *ctx) {
   JSValue global = JS_GetGlobalObject(ctx);
   JS_SetPropertyStr(ctx, global, "cube", JS_NewCFunction(ctx, JsCube, "cube", 1));
@@ -1380,6 +2757,12 @@ void RegisterBindingsInternal(JSContext *ctx) {
                     JS_NewCFunction(ctx, JsSlice, "slice", 2));
   JS_SetPropertyStr(ctx, global, "project",
                     JS_NewCFunction(ctx, JsProject, "project", 1));
+  JS_SetPropertyStr(ctx, global, "sliceFlat",
+                    JS_NewCFunction(ctx, JsSliceFlat, "sliceFlat", 2));
+  JS_SetPropertyStr(ctx, global, "projectFlat",
+                    JS_NewCFunction(ctx, JsProjectFlat, "projectFlat", 1));
+  JS_SetPropertyStr(ctx, global, "meshData",
+                    JS_NewCFunction(ctx, JsMeshData, "meshData", 1));
   JS_SetPropertyStr(ctx, global, "extrude",
                     JS_NewCFunction(ctx, JsExtrude, "extrude", 2));
   JS_SetPropertyStr(ctx, global, "revolve",
@@ -1388,10 +2771,41 @@ void RegisterBindingsInternal(JSContext *ctx) {
                     JS_NewCFunction(ctx, JsBooleanOp, "boolean", 3));
   JS_SetPropertyStr(ctx, global, "batchBoolean",
                     JS_NewCFunction(ctx, JsBatchBoolean, "batchBoolean", 2));
+  JSValue sdfObj = JS_NewObject(ctx);
+  struct SdfFunction {
+    const char *name;
+    JSCFunction *func;
+    int length;
+  };
+  const SdfFunction sdfFunctions[] = {
+      {"sphere", JsSdfSphere, 1},
+      {"box", JsSdfBox, 1},
+      {"cylinder", JsSdfCylinder, 2},
+      {"torus", JsSdfTorus, 2},
+      {"plane", JsSdfPlane, 1},
+      {"gyroid", JsSdfGyroid, 2},
+      {"union", JsSdfUnion, 1},
+      {"intersection", JsSdfIntersection, 1},
+      {"difference", JsSdfDifference, 1},
+      {"smoothUnion", JsSdfSmoothUnion, 3},
+      {"smoothIntersection", JsSdfSmoothIntersection, 3},
+      {"smoothDifference", JsSdfSmoothDifference, 3},
+      {"translate", JsSdfTranslate, 2},
+      {"rotate", JsSdfRotate, 2},
+      {"scale", JsSdfScale, 2},
+      {"shell", JsSdfShell, 2},
+      {"offset", JsSdfOffset, 2},
+  };
+  for (const auto &[name, func, length] : sdfFunctions) {
+    JS_SetPropertyStr(ctx, sdfObj, name, JS_NewCFunction(ctx, func, name, length));
+  }
+  JS_SetPropertyStr(ctx, global, "sdf", sdfObj);
   JS_SetPropertyStr(ctx, global, "levelSet",
                     JS_NewCFunction(ctx, JsLevelSet, "levelSet", 1));
   JS_SetPropertyStr(ctx, global, "loadMesh",
                     JS_NewCFunction(ctx, JsLoadMesh, "loadMesh", 2));
+  JS_SetPropertyStr(ctx, global, "cached",
+                    JS_NewCFunction(ctx, JsCached, "cached", 2));
   JS_SetPropertyStr(ctx, global, "asOriginal",
                     JS_NewCFunction(ctx, JsAsOriginal, "asOriginal", 1));
   JS_SetPropertyStr(ctx, global, "originalId",
@@ -1425,11 +2839,95 @@ void EnsureManifoldClass(JSRuntime *runtime) {
   EnsureManifoldClassInternal(runtime);
 }
 
+void SetEvalQuality(JSRuntime *runtime, EvalQuality quality) {
+  if (BindingState *state = GetBindingState(runtime)) state->quality = quality;
+}
+
+void FreeBindingState(JSRuntime *runtime) {
+  delete GetBindingState(runtime);
+  JS_SetRuntimeOpaque(runtime, nullptr);
+}
+
+GeometryCacheStats SweepGeometryCache(JSRuntime *runtime) {
+  GeometryCacheStats stats;
+  BindingState *state = GetBindingState(runtime);
+  if (!state) return stats;
+  GeometryCache &cache = state->geometryCache;
+  for (auto it = cache.entries.begin(); it != cache.entries.end();) {
+    if (it->second.generation < cache.generation) {
+      it = cache.entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  stats.hits = cache.hits;
+  stats.misses = cache.misses;
+  stats.entries = cache.entries.size();
+  cache.hits = 0;
+  cache.misses = 0;
+  ++cache.generation;
+  return stats;
+}
+
+void ResetGeometryCacheStats(JSRuntime *runtime) {
+  BindingState *state = GetBindingState(runtime);
+  if (!state) return;
+  state->geometryCache.hits = 0;
+  state->geometryCache.misses = 0;
+}
+
 void RegisterBindings(JSContext *ctx) {
   RegisterBindingsInternal(ctx);
 }
 
 std::shared_ptr<manifold::Manifold> GetManifoldHandle(JSContext *ctx,
                                                       JSValueConst value) {
-  return GetManifoldHandleInternal(ctx, value);
+  JsManifold *jsManifold = GetJsManifold(ctx, value);
+  if (!jsManifold) return nullptr;
+  EvaluateInParallel(ctx, {jsManifold->hash});
+  return jsManifold->handle;
+}
+
+bool GetScenePlacements(JSContext *ctx, JSValueConst value,
+                        std::vector<ScenePlacement> &placements) {
+  if (!JS_IsArray(value)) {
+    JS_ThrowTypeError(ctx, "scene placements must be an array");
+    return false;
+  }
+  JSValue lengthVal = JS_GetPropertyStr(ctx, value, "length");
+  uint32_t len = 0;
+  if (JS_ToUint32(ctx, &len, lengthVal) < 0) {
+    JS_FreeValue(ctx, lengthVal);
+    return false;
+  }
+  JS_FreeValue(ctx, lengthVal);
+  placements.reserve(len);
+  std::vector<uint64_t> hashes;
+  for (uint32_t i = 0; i < len; ++i) {
+    JSValue item = JS_GetPropertyUint32(ctx, value, i);
+    if (JS_IsException(item)) return false;
+    if (!JS_IsObject(item)) {
+      JS_FreeValue(ctx, item);
+      JS_ThrowTypeError(ctx, "scene placement %u must be {manifold, transform?}", i);
+      return false;
+    }
+    JSValue manifoldVal = JS_GetPropertyStr(ctx, item, "manifold");
+    JSValue transformVal = JS_GetPropertyStr(ctx, item, "transform");
+    JS_FreeValue(ctx, item);
+    JsManifold *jsManifold = GetJsManifold(ctx, manifoldVal);
+    ScenePlacement placement{
+        jsManifold ? jsManifold->handle : nullptr,
+        manifold::mat3x4(manifold::vec3(1, 0, 0), manifold::vec3(0, 1, 0),
+                         manifold::vec3(0, 0, 1), manifold::vec3(0, 0, 0))};
+    if (jsManifold) hashes.push_back(jsManifold->hash);
+    JS_FreeValue(ctx, manifoldVal);
+    const bool ok = placement.manifold &&
+                    (JS_IsUndefined(transformVal) ||
+                     GetMat3x4(ctx, transformVal, placement.transform));
+    JS_FreeValue(ctx, transformVal);
+    if (!ok) return false;
+    placements.push_back(std::move(placement));
+  }
+  EvaluateInParallel(ctx, hashes);
+  return true;
 }
\ No newline at end of file
@@ -4,13 +4,47 @@ extern "C" {
 #include "quickjs.h"
 }
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
-namespace manifold {
-class Manifold;
-}
+#include "manifold/manifold.h"
 
 void EnsureManifoldClass(JSRuntime *runtime);
+void FreeBindingState(JSRuntime *runtime);
+
+// Tessellation level for scene evaluation on one runtime. Preview coarsens
+// circles (sphere, cylinder, revolve), levelSet edge lengths and refine*
+// targets for fast interactive reloads. Results are keyed by the effective
+// values, so both levels share the geometry cache without mixing.
+enum class EvalQuality { Full, Preview };
+void SetEvalQuality(JSRuntime *runtime, EvalQuality quality);
 void RegisterBindings(JSContext *ctx);
 std::shared_ptr<manifold::Manifold> GetManifoldHandle(JSContext *ctx,
                                                       JSValueConst value);
+
+// One copy of a manifold in a scene exported as an array of placements.
+struct ScenePlacement {
+  std::shared_ptr<manifold::Manifold> manifold;
+  manifold::mat3x4 transform;
+};
+
+// Reads `[{manifold, transform?}, ...]`, where transform takes the same 12
+// numbers as transform(). Throws a JS exception and returns false on bad input.
+bool GetScenePlacements(JSContext *ctx, JSValueConst value,
+                        std::vector<ScenePlacement> &placements);
+
+struct GeometryCacheStats {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t entries = 0;
+};
+
+// Ends one scene evaluation: drops cached geometry the evaluation did not use
+// and returns how many binding calls were served from the cache.
+GeometryCacheStats SweepGeometryCache(JSRuntime *runtime);
+
+// Ends a failed scene evaluation: zeroes the hit/miss counts so the next
+// evaluation reports only its own, but keeps every cached result (the retry
+// after a fix usually needs most of them).
+void ResetGeometryCacheStats(JSRuntime *runtime);
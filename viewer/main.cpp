@@ -2,28 +2,53 @@
 #include "raymath.h"
 #include "rlgl.h"
 
+// Only for instanced draws with 32-bit indices and the per-instance matrix
+// attribute, which rlgl does not expose.
+#if defined(__EMSCRIPTEN__)
+#include <GLES3/gl3.h>
+#elif defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#endif
+
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 #include <emscripten/html5.h>
 #include <cstring>
 #endif
 
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <cerrno>
 #include <cmath>
+#include <cstddef>
+#include <cstdio>
 #include <cstring>
 #include <cstdlib>
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <sstream>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include <utility>
@@ -35,6 +60,10 @@ extern "C" {
 #include "manifold/manifold.h"
 #include "manifold/polygon.h"
 #include "js_bindings.h"
+#include "mesh_io.h"
+#include "parallel.h"
+#include "scene_loader.h"
+#include "script_thread.h"
 
 // Version header (generated at build time)
 #ifdef BUILD_VERSION
@@ -68,21 +97,36 @@ constexpr float kBrandFontSize = 28.0f;
 constexpr float kSceneScale = 0.1f;  // convert mm scene units to renderer units
 
 // GLSL 330 core (desktop). Uses raylib's default attribute/uniform names.
+// Mesh vertices are compact (see CreateGpuMesh): vertexPosition is 16-bit,
+// normalized to the mesh bounds, and vertexNormal is octahedral-encoded.
+// Every mesh is drawn instanced; instanceTransform places each copy and
+// instanceNormal (its inverse-transpose) carries the normals.
 const char* kOutlineVS = R"glsl(
 #version 330
 
 in vec3 vertexPosition;
-in vec3 vertexNormal;
+in vec2 vertexNormal;
+layout(location = 8) in mat4 instanceTransform;
+layout(location = 12) in mat3 instanceNormal;
 
 uniform mat4 mvp;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
 uniform float outline;   // world-units thickness
 
+vec3 octDecode(vec2 e){
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
+
 void main()
 {
-    // Expand along the vertex normal in model space. This is robust as long as
-    // your model transform has no non-uniform scale (true in your code).
-    vec3 pos = vertexPosition + normalize(vertexNormal) * outline;
-    gl_Position = mvp * vec4(pos, 1.0);
+    // Expand along the placed normal, after the instance transform, so scaled
+    // copies get the same thickness. matModel is a uniform scale.
+    vec4 ipos = instanceTransform * vec4(positionOffset + vertexPosition * positionScale, 1.0);
+    vec3 n = normalize(instanceNormal * octDecode(vertexNormal));
+    gl_Position = mvp * vec4(ipos.xyz + n * outline, 1.0);
 }
 )glsl";
 
@@ -104,19 +148,29 @@ void main()
 const char* kToonVS = R"glsl(
 #version 330
 in vec3 vertexPosition;
-in vec3 vertexNormal;
+in vec2 vertexNormal;
+layout(location = 8) in mat4 instanceTransform;
+layout(location = 12) in mat3 instanceNormal;
 uniform mat4 mvp;
 uniform mat4 matModel;
 uniform mat4 matView;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
 out vec3 vNvs;
 out vec3 vVdir; // view dir in view space
+vec3 octDecode(vec2 e){
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
 void main() {
-    vec4 wpos = matModel * vec4(vertexPosition, 1.0);
-    vec3 nvs  = mat3(matView) * mat3(matModel) * vertexNormal;
+    vec4 ipos = instanceTransform * vec4(positionOffset + vertexPosition * positionScale, 1.0);
+    vec4 wpos = matModel * ipos;
+    vec3 nvs  = mat3(matView) * mat3(matModel) * instanceNormal * octDecode(vertexNormal);
     vNvs      = normalize(nvs);
     vec3 vpos = (matView * wpos).xyz;
     vVdir     = normalize(-vpos);
-    gl_Position = mvp * vec4(vertexPosition, 1.0);
+    gl_Position = mvp * ipos;
 }
 )glsl";
 
@@ -164,18 +218,28 @@ void main() {
 const char* kNormalDepthVS = R"glsl(
 #version 330
 in vec3 vertexPosition;
-in vec3 vertexNormal;
+in vec2 vertexNormal;
+layout(location = 8) in mat4 instanceTransform;
+layout(location = 12) in mat3 instanceNormal;
 uniform mat4 mvp;
 uniform mat4 matModel;
 uniform mat4 matView;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
 out vec3 nVS;
 out float depthLin;
+vec3 octDecode(vec2 e){
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
 void main() {
-    vec4 wpos = matModel * vec4(vertexPosition, 1.0);
+    vec4 ipos = instanceTransform * vec4(positionOffset + vertexPosition * positionScale, 1.0);
+    vec4 wpos = matModel * ipos;
     vec3 vpos = (matView * wpos).xyz;
-    nVS = normalize(mat3(matView) * mat3(matModel) * vertexNormal);
+    nVS = normalize(mat3(matView) * mat3(matModel) * instanceNormal * octDecode(vertexNormal));
     depthLin = -vpos.z; // linear view-space depth
-    gl_Position = mvp * vec4(vertexPosition, 1.0);
+    gl_Position = mvp * ipos;
 }
 )glsl";
 
@@ -247,302 +311,320 @@ void main(){
 }
 )glsl";
 
-struct Vec3f {
-  float x;
-  float y;
-  float z;
-};
-
-struct ModuleLoaderData {
-  std::filesystem::path baseDir;
-  std::set<std::filesystem::path> dependencies;
-};
-
 ModuleLoaderData g_module_loader_data;
 
 struct WatchedFile {
   std::optional<std::filesystem::file_time_type> timestamp;
 };
 
-Vec3f FetchVertex(const manifold::MeshGL &mesh, uint32_t index) {
-  const size_t offset = static_cast<size_t>(index) * mesh.numProp;
-  return {
-      static_cast<float>(mesh.vertProperties[offset + 0]),
-      static_cast<float>(mesh.vertProperties[offset + 1]),
-      static_cast<float>(mesh.vertProperties[offset + 2])
-  };
-}
+// One drawn copy of a GpuMesh: its column-major model matrix, and the
+// inverse-transpose of the matrix's linear part for normals, so placements
+// may scale non-uniformly or shear.
+struct InstanceTransform {
+  std::array<float, 16> model;
+  std::array<float, 9> normal;  // column-major 3x3
+};
 
-Vec3f Subtract(const Vec3f &a, const Vec3f &b) {
-  return {a.x - b.x, a.y - b.y, a.z - b.z};
+// First attribute slots of instanceTransform's four columns and of
+// instanceNormal's three; must match the layout qualifiers in the shaders.
+constexpr unsigned int kInstanceTransformLocation = 8;
+constexpr unsigned int kInstanceNormalLocation = 12;
+
+// True if the copy is mirrored (negative determinant), which reverses the
+// winding of its triangles.
+bool IsMirrored(const InstanceTransform &instance) {
+  const auto &m = instance.model;
+  const float det = m[0] * (m[5] * m[10] - m[6] * m[9]) - m[1] * (m[4] * m[10] - m[6] * m[8]) +
+                    m[2] * (m[4] * m[9] - m[5] * m[8]);
+  return det < 0.0f;
 }
 
-Vec3f Cross(const Vec3f &a, const Vec3f &b) {
-  return {a.y * b.z - a.z * b.y,
-          a.z * b.x - a.x * b.z,
-          a.x * b.y - a.y * b.x};
-}
+// The scene on the GPU: one vertex array with 32-bit indices, so a mesh of any
+// size is a single draw call per pass and no vertices are duplicated.
+// Vertices are 12 bytes: positions as 16-bit fractions of the bounding box
+// (padded to 8 bytes), normals octahedral-encoded into two 16-bit snorms.
+// Repeated copies are instances of one mesh rather than more vertices.
+struct GpuMesh {
+  unsigned int vao = 0;
+  unsigned int positionVbo = 0;
+  unsigned int normalVbo = 0;
+  unsigned int indexVbo = 0;
+  unsigned int instanceVbo = 0;
+  int indexCount = 0;
+  int instanceCount = 0;
+  int mirroredCount = 0;  // the last instances in instanceVbo, drawn front face flipped
+  Vector3 positionOffset = {0.0f, 0.0f, 0.0f};  // bounding box min
+  Vector3 positionScale = {0.0f, 0.0f, 0.0f};   // bounding box size
+  uint64_t contentHash = 0;                     // ScenePart::hash it was built from
+};
 
-Vec3f Normalize(const Vec3f &v) {
-  const float lenSq = v.x * v.x + v.y * v.y + v.z * v.z;
-  if (lenSq <= 0.0f) return {0.0f, 0.0f, 0.0f};
-  const float invLen = 1.0f / std::sqrt(lenSq);
-  return {v.x * invLen, v.y * invLen, v.z * invLen};
+// The scene is one GpuMesh per part (see SplitSceneParts).
+using GpuScene = std::vector<GpuMesh>;
+
+void DestroyGpuMesh(GpuMesh &mesh) {
+  if (mesh.vao != 0) rlUnloadVertexArray(mesh.vao);
+  if (mesh.positionVbo != 0) rlUnloadVertexBuffer(mesh.positionVbo);
+  if (mesh.normalVbo != 0) rlUnloadVertexBuffer(mesh.normalVbo);
+  if (mesh.indexVbo != 0) rlUnloadVertexBuffer(mesh.indexVbo);
+  if (mesh.instanceVbo != 0) rlUnloadVertexBuffer(mesh.instanceVbo);
+  mesh = GpuMesh{};
 }
 
-bool WriteMeshAsBinaryStl(const manifold::MeshGL &mesh,
-                          const std::filesystem::path &path,
-                          std::string &error) {
-  const uint32_t triCount = static_cast<uint32_t>(mesh.NumTri());
-  if (triCount == 0) {
-    error = "Export failed: mesh is empty";
-    return false;
+// Points the bound vertex array's instance attributes at `vbo`, starting at
+// instance `first`.
+void PointInstanceAttributes(unsigned int vbo, int first) {
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  const size_t base = static_cast<size_t>(first) * sizeof(InstanceTransform);
+  for (unsigned int column = 0; column < 4; ++column) {
+    const unsigned int location = kInstanceTransformLocation + column;
+    const size_t offset = base + offsetof(InstanceTransform, model) + column * 4 * sizeof(float);
+    glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceTransform),
+                          reinterpret_cast<const void *>(offset));
+    glEnableVertexAttribArray(location);
+    glVertexAttribDivisor(location, 1);
+  }
+  for (unsigned int column = 0; column < 3; ++column) {
+    const unsigned int location = kInstanceNormalLocation + column;
+    const size_t offset = base + offsetof(InstanceTransform, normal) + column * 3 * sizeof(float);
+    glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceTransform),
+                          reinterpret_cast<const void *>(offset));
+    glEnableVertexAttribArray(location);
+    glVertexAttribDivisor(location, 1);
   }
+}
 
-  std::ofstream out(path, std::ios::binary);
-  if (!out) {
-    error = "Export failed: cannot open " + path.string();
-    return false;
+// Replaces the matrices the mesh is drawn with, one instance each. An empty
+// list draws the mesh once, untransformed. Mirrored instances are moved to
+// the end so they can be drawn with the front face flipped.
+void SetGpuMeshInstances(GpuMesh &mesh, const std::vector<InstanceTransform> &instances) {
+  static const InstanceTransform kIdentity = {
+      {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+       1.0f},
+      {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f}};
+  std::vector<InstanceTransform> ordered =
+      instances.empty() ? std::vector<InstanceTransform>{kIdentity} : instances;
+  const auto mirrored = std::stable_partition(
+      ordered.begin(), ordered.end(),
+      [](const InstanceTransform &instance) { return !IsMirrored(instance); });
+  mesh.mirroredCount = static_cast<int>(ordered.end() - mirrored);
+  const int count = static_cast<int>(ordered.size());
+  const int bytes = count * static_cast<int>(sizeof(InstanceTransform));
+  if (mesh.instanceVbo != 0 && count == mesh.instanceCount) {
+    rlUpdateVertexBuffer(mesh.instanceVbo, ordered.data(), bytes, 0);
+    return;
   }
 
-  std::array<char, 80> header{};
-  constexpr const char kHeader[] = "dingcad export";
-  std::memcpy(header.data(), kHeader, std::min(header.size(), std::strlen(kHeader)));
-  out.write(header.data(), header.size());
-  out.write(reinterpret_cast<const char *>(&triCount), sizeof(uint32_t));
-
-  for (uint32_t tri = 0; tri < triCount; ++tri) {
-    const uint32_t i0 = mesh.triVerts[tri * 3 + 0];
-    const uint32_t i1 = mesh.triVerts[tri * 3 + 1];
-    const uint32_t i2 = mesh.triVerts[tri * 3 + 2];
-
-    const Vec3f v0 = FetchVertex(mesh, i0);
-    const Vec3f v1 = FetchVertex(mesh, i1);
-    const Vec3f v2 = FetchVertex(mesh, i2);
-
-    const Vec3f normal = Normalize(Cross(Subtract(v1, v0), Subtract(v2, v0)));
+  rlEnableVertexArray(mesh.vao);
+  if (mesh.instanceVbo != 0) rlUnloadVertexBuffer(mesh.instanceVbo);
+  mesh.instanceVbo = rlLoadVertexBuffer(ordered.data(), bytes, false);
+  PointInstanceAttributes(mesh.instanceVbo, 0);
+  rlDisableVertexArray();
+  mesh.instanceCount = count;
+}
 
-    out.write(reinterpret_cast<const char *>(&normal), sizeof(Vec3f));
-    out.write(reinterpret_cast<const char *>(&v0), sizeof(Vec3f));
-    out.write(reinterpret_cast<const char *>(&v1), sizeof(Vec3f));
-    out.write(reinterpret_cast<const char *>(&v2), sizeof(Vec3f));
-    const uint16_t attr = 0;
-    out.write(reinterpret_cast<const char *>(&attr), sizeof(uint16_t));
-  }
+// Equivalent of DrawMesh for a GpuMesh: sets the matrices raylib's shaders
+// expect, plus the bounds that dequantize positions, and issues one indexed
+// draw for all instances.
+void DrawGpuMesh(const GpuMesh &mesh, const Shader &shader) {
+  if (mesh.vao == 0 || mesh.indexCount == 0) return;
+  const int locOffset = GetShaderLocation(shader, "positionOffset");
+  const int locScale = GetShaderLocation(shader, "positionScale");
+  if (locOffset != -1) SetShaderValue(shader, locOffset, &mesh.positionOffset, SHADER_UNIFORM_VEC3);
+  if (locScale != -1) SetShaderValue(shader, locScale, &mesh.positionScale, SHADER_UNIFORM_VEC3);
+  const Matrix view = rlGetMatrixModelview();
+  const Matrix projection = rlGetMatrixProjection();
+  const Matrix model = rlGetMatrixTransform();
+  const Matrix mvp = MatrixMultiply(MatrixMultiply(model, view), projection);
+
+  rlEnableShader(shader.id);
+  if (shader.locs[SHADER_LOC_MATRIX_MVP] != -1) {
+    rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MVP], mvp);
+  }
+  if (shader.locs[SHADER_LOC_MATRIX_MODEL] != -1) {
+    rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MODEL], model);
+  }
+  if (shader.locs[SHADER_LOC_MATRIX_VIEW] != -1) {
+    rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_VIEW], view);
+  }
+  if (shader.locs[SHADER_LOC_MATRIX_PROJECTION] != -1) {
+    rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_PROJECTION], projection);
+  }
+  rlEnableVertexArray(mesh.vao);
+  const int unmirrored = mesh.instanceCount - mesh.mirroredCount;
+  if (unmirrored > 0) {
+    glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, nullptr, unmirrored);
+  }
+  if (mesh.mirroredCount > 0) {
+    // Mirrored copies wind clockwise; flip the front face so culling and
+    // gl_FrontFacing treat them like the rest.
+    PointInstanceAttributes(mesh.instanceVbo, unmirrored);
+    glFrontFace(GL_CW);
+    glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, nullptr,
+                            mesh.mirroredCount);
+    glFrontFace(GL_CCW);
+    PointInstanceAttributes(mesh.instanceVbo, 0);
+  }
+  rlDisableVertexArray();
+  rlDisableShader();
+}
 
-  if (!out) {
-    error = "Export failed: write error";
-    return false;
-  }
+void DestroyGpuScene(GpuScene &scene) {
+  for (auto &mesh : scene) DestroyGpuMesh(mesh);
+  scene.clear();
+}
 
-  return true;
+void DrawGpuScene(const GpuScene &scene, const Shader &shader) {
+  for (const auto &mesh : scene) DrawGpuMesh(mesh, shader);
 }
 
-void DestroyModel(Model &model) {
-  if (model.meshes != nullptr || model.materials != nullptr) {
-    UnloadModel(model);
-  }
-  model = Model{};
+// Octahedral normal encoding: folds the unit sphere onto [-1, 1]^2 and stores
+// it as two snorm16 values. Decoded by octDecode in the vertex shaders.
+std::array<int16_t, 2> EncodeOctahedral(const Vector3 &n) {
+  const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+  float x = l1 > 0.0f ? n.x / l1 : 0.0f;
+  float y = l1 > 0.0f ? n.y / l1 : 0.0f;
+  if (n.z < 0.0f) {
+    const float fx = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+    const float fy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+    x = fx;
+    y = fy;
+  }
+  return {static_cast<int16_t>(std::lround(Clamp(x, -1.0f, 1.0f) * 32767.0f)),
+          static_cast<int16_t>(std::lround(Clamp(y, -1.0f, 1.0f) * 32767.0f))};
 }
 
-Model CreateRaylibModelFrom(const manifold::MeshGL &meshGL) {
-  Model model = {0};
+GpuMesh CreateGpuMesh(const manifold::MeshGL &meshGL) {
+  GpuMesh mesh;
   const int vertexCount = meshGL.NumVert();
   const int triangleCount = meshGL.NumTri();
 
   if (vertexCount <= 0 || triangleCount <= 0) {
-    return model;
+    return mesh;
   }
 
-  const int stride = meshGL.numProp;
+  const size_t stride = meshGL.numProp;
   std::vector<Vector3> positions(vertexCount);
-  for (int v = 0; v < vertexCount; ++v) {
-    const int base = v * stride;
-    // Convert from the scene's Z-up coordinates to raylib's Y-up system.
-    const float cadX = meshGL.vertProperties[base + 0] * kSceneScale;
-    const float cadY = meshGL.vertProperties[base + 1] * kSceneScale;
-    const float cadZ = meshGL.vertProperties[base + 2] * kSceneScale;
-    positions[v] = {cadX, cadZ, -cadY};
-  }
-
-  std::vector<Vector3> accum(vertexCount, {0.0f, 0.0f, 0.0f});
-  for (int tri = 0; tri < triangleCount; ++tri) {
-    const int i0 = meshGL.triVerts[tri * 3 + 0];
-    const int i1 = meshGL.triVerts[tri * 3 + 1];
-    const int i2 = meshGL.triVerts[tri * 3 + 2];
-
-    const Vector3 p0 = positions[i0];
-    const Vector3 p1 = positions[i1];
-    const Vector3 p2 = positions[i2];
-
-    const Vector3 u = {p1.x - p0.x, p1.y - p0.y, p1.z - p0.z};
-    const Vector3 v = {p2.x - p0.x, p2.y - p0.y, p2.z - p0.z};
-    const Vector3 n = {u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z,
-                       u.x * v.y - u.y * v.x};
-
-    accum[i0].x += n.x;
-    accum[i0].y += n.y;
-    accum[i0].z += n.z;
-    accum[i1].x += n.x;
-    accum[i1].y += n.y;
-    accum[i1].z += n.z;
-    accum[i2].x += n.x;
-    accum[i2].y += n.y;
-    accum[i2].z += n.z;
-  }
-
-  std::vector<Vector3> normals(vertexCount);
-  std::vector<Color> colors(vertexCount);
-  const Vector3 lightDir = Vector3Normalize({0.45f, 0.85f, 0.35f});
-  for (int v = 0; v < vertexCount; ++v) {
-    const Vector3 n = accum[v];
-    const float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
-
-    Vector3 normal = {0.0f, 1.0f, 0.0f};
-    if (length > 0.0f) {
-      normal = {n.x / length, n.y / length, n.z / length};
+  Vector3 boundsMin = {INFINITY, INFINITY, INFINITY};
+  Vector3 boundsMax = {-INFINITY, -INFINITY, -INFINITY};
+  std::mutex boundsMutex;
+  ParallelFor(vertexCount, [&](size_t begin, size_t end) {
+    Vector3 lo = {INFINITY, INFINITY, INFINITY};
+    Vector3 hi = {-INFINITY, -INFINITY, -INFINITY};
+    for (size_t v = begin; v < end; ++v) {
+      const size_t base = v * stride;
+      // Convert from the scene's Z-up coordinates to raylib's Y-up system.
+      const float cadX = meshGL.vertProperties[base + 0] * kSceneScale;
+      const float cadY = meshGL.vertProperties[base + 1] * kSceneScale;
+      const float cadZ = meshGL.vertProperties[base + 2] * kSceneScale;
+      positions[v] = {cadX, cadZ, -cadY};
+      lo = Vector3Min(lo, positions[v]);
+      hi = Vector3Max(hi, positions[v]);
     }
-    normals[v] = normal;
-
-    float intensity = Vector3DotProduct(normal, lightDir);
-    intensity = Clamp(intensity, 0.0f, 1.0f);
-    constexpr int toonSteps = 3;
-    int level = static_cast<int>(std::floor(intensity * toonSteps));
-    if (level >= toonSteps) level = toonSteps - 1;
-    const float toon = (toonSteps > 1)
-                           ? static_cast<float>(level) /
-                                 static_cast<float>(toonSteps - 1)
-                           : intensity;
-    const float ambient = 0.3f;
-    const float diffuse = 0.7f;
-    float finalIntensity = Clamp(ambient + diffuse * toon, 0.0f, 1.0f);
-
-    const Color base = kBaseColor;
-    Color color = {0};
-    color.r = static_cast<unsigned char>(
-        Clamp(base.r * finalIntensity, 0.0f, 255.0f));
-    color.g = static_cast<unsigned char>(
-        Clamp(base.g * finalIntensity, 0.0f, 255.0f));
-    color.b = static_cast<unsigned char>(
-        Clamp(base.b * finalIntensity, 0.0f, 255.0f));
-    color.a = base.a;
-    colors[v] = color;
-  }
-
-  constexpr int kMaxVerticesPerMesh = std::numeric_limits<unsigned short>::max();
-  std::vector<int> remap(vertexCount, 0);
-  std::vector<int> remapMarker(vertexCount, 0);
-  int chunkToken = 1;
-
-  std::vector<Mesh> meshes;
-  meshes.reserve(
-      static_cast<size_t>(triangleCount) / kMaxVerticesPerMesh + 1);
-
-  int triIndex = 0;
-  while (triIndex < triangleCount) {
-    const int currentToken = chunkToken++;
-    int chunkVertexCount = 0;
-    std::vector<Vector3> chunkPositions;
-    std::vector<Vector3> chunkNormals;
-    std::vector<Color> chunkColors;
-    std::vector<unsigned short> chunkIndices;
-
-    chunkPositions.reserve(std::min(kMaxVerticesPerMesh, vertexCount));
-    chunkNormals.reserve(std::min(kMaxVerticesPerMesh, vertexCount));
-    chunkColors.reserve(std::min(kMaxVerticesPerMesh, vertexCount));
-    chunkIndices.reserve(std::min(kMaxVerticesPerMesh, vertexCount) * 3);
-
-    while (triIndex < triangleCount) {
-      const int indices[3] = {
-          static_cast<int>(meshGL.triVerts[triIndex * 3 + 0]),
-          static_cast<int>(meshGL.triVerts[triIndex * 3 + 1]),
-          static_cast<int>(meshGL.triVerts[triIndex * 3 + 2])};
-
-      int needed = 0;
+    std::lock_guard<std::mutex> lock(boundsMutex);
+    boundsMin = Vector3Min(boundsMin, lo);
+    boundsMax = Vector3Max(boundsMax, hi);
+  });
+  mesh.positionOffset = boundsMin;
+  mesh.positionScale = Vector3Subtract(boundsMax, boundsMin);
+
+  // Area-weighted face normals, plus how many faces touch each vertex.
+  std::vector<Vector3> faceNormals(triangleCount);
+  std::unique_ptr<std::atomic<int>[]> faceCounts(new std::atomic<int>[vertexCount]());
+  ParallelFor(triangleCount, [&](size_t begin, size_t end) {
+    for (size_t tri = begin; tri < end; ++tri) {
+      const uint32_t i0 = meshGL.triVerts[tri * 3 + 0];
+      const uint32_t i1 = meshGL.triVerts[tri * 3 + 1];
+      const uint32_t i2 = meshGL.triVerts[tri * 3 + 2];
+
+      const Vector3 p0 = positions[i0];
+      const Vector3 p1 = positions[i1];
+      const Vector3 p2 = positions[i2];
+
+      const Vector3 u = {p1.x - p0.x, p1.y - p0.y, p1.z - p0.z};
+      const Vector3 v = {p2.x - p0.x, p2.y - p0.y, p2.z - p0.z};
+      faceNormals[tri] = {u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z,
+                          u.x * v.y - u.y * v.x};
+      faceCounts[i0].fetch_add(1, std::memory_order_relaxed);
+      faceCounts[i1].fetch_add(1, std::memory_order_relaxed);
+      faceCounts[i2].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  // Vertex -> face adjacency (CSR), so each vertex sums its own faces and no
+  // two threads write the same normal.
+  std::vector<int> firstFace(vertexCount + 1, 0);
+  for (int v = 0; v < vertexCount; ++v) {
+    firstFace[v + 1] = firstFace[v] + faceCounts[v].load(std::memory_order_relaxed);
+    faceCounts[v].store(firstFace[v], std::memory_order_relaxed);
+  }
+  std::vector<int> vertexFaces(firstFace[vertexCount]);
+  ParallelFor(triangleCount, [&](size_t begin, size_t end) {
+    for (size_t tri = begin; tri < end; ++tri) {
       for (int j = 0; j < 3; ++j) {
-        if (remapMarker[indices[j]] != currentToken) {
-          ++needed;
-        }
+        const uint32_t vert = meshGL.triVerts[tri * 3 + j];
+        vertexFaces[faceCounts[vert].fetch_add(1, std::memory_order_relaxed)] =
+            static_cast<int>(tri);
       }
+    }
+  });
 
-      if (chunkVertexCount + needed > kMaxVerticesPerMesh) {
-        break;
+  // Quantized positions (x, y, z, pad) and encoded normals. The scene has
+  // no color channel, and the toon shader lights every fragment itself, so
+  // there is no per-vertex color.
+  std::vector<uint16_t> packedPositions(static_cast<size_t>(vertexCount) * 4, 0);
+  std::vector<int16_t> packedNormals(static_cast<size_t>(vertexCount) * 2);
+  const float extent[3] = {mesh.positionScale.x, mesh.positionScale.y, mesh.positionScale.z};
+  const float origin[3] = {boundsMin.x, boundsMin.y, boundsMin.z};
+  ParallelFor(vertexCount, [&](size_t begin, size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      const float p[3] = {positions[v].x, positions[v].y, positions[v].z};
+      for (int axis = 0; axis < 3; ++axis) {
+        const float t = extent[axis] > 0.0f ? (p[axis] - origin[axis]) / extent[axis] : 0.0f;
+        packedPositions[v * 4 + axis] =
+            static_cast<uint16_t>(std::lround(Clamp(t, 0.0f, 1.0f) * 65535.0f));
       }
 
-      for (int j = 0; j < 3; ++j) {
-        const int original = indices[j];
-        if (remapMarker[original] != currentToken) {
-          remapMarker[original] = currentToken;
-          remap[original] = chunkVertexCount++;
-          chunkPositions.push_back(positions[original]);
-          chunkNormals.push_back(normals[original]);
-          chunkColors.push_back(colors[original]);
-        }
-        chunkIndices.push_back(static_cast<unsigned short>(remap[original]));
+      Vector3 n = {0.0f, 0.0f, 0.0f};
+      for (int f = firstFace[v]; f < firstFace[v + 1]; ++f) {
+        const Vector3 &face = faceNormals[vertexFaces[f]];
+        n.x += face.x;
+        n.y += face.y;
+        n.z += face.z;
       }
-      ++triIndex;
-    }
+      const float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
 
-    Mesh chunkMesh = {0};
-    chunkMesh.vertexCount = chunkVertexCount;
-    chunkMesh.triangleCount = static_cast<int>(chunkIndices.size() / 3);
-    chunkMesh.vertices = static_cast<float *>(
-        MemAlloc(chunkVertexCount * 3 * sizeof(float)));
-    chunkMesh.normals = static_cast<float *>(
-        MemAlloc(chunkVertexCount * 3 * sizeof(float)));
-    chunkMesh.colors = static_cast<unsigned char *>(
-        MemAlloc(chunkVertexCount * 4 * sizeof(unsigned char)));
-    chunkMesh.indices = static_cast<unsigned short *>(
-        MemAlloc(chunkIndices.size() * sizeof(unsigned short)));
-    chunkMesh.texcoords = nullptr;
-    chunkMesh.texcoords2 = nullptr;
-    chunkMesh.tangents = nullptr;
-
-    for (int v = 0; v < chunkVertexCount; ++v) {
-      const Vector3 &pos = chunkPositions[v];
-      chunkMesh.vertices[v * 3 + 0] = pos.x;
-      chunkMesh.vertices[v * 3 + 1] = pos.y;
-      chunkMesh.vertices[v * 3 + 2] = pos.z;
-
-      const Vector3 &normal = chunkNormals[v];
-      chunkMesh.normals[v * 3 + 0] = normal.x;
-      chunkMesh.normals[v * 3 + 1] = normal.y;
-      chunkMesh.normals[v * 3 + 2] = normal.z;
-
-      const Color color = chunkColors[v];
-      chunkMesh.colors[v * 4 + 0] = color.r;
-      chunkMesh.colors[v * 4 + 1] = color.g;
-      chunkMesh.colors[v * 4 + 2] = color.b;
-      chunkMesh.colors[v * 4 + 3] = color.a;
+      Vector3 normal = {0.0f, 1.0f, 0.0f};
+      if (length > 0.0f) {
+        normal = {n.x / length, n.y / length, n.z / length};
+      }
+      const auto encoded = EncodeOctahedral(normal);
+      packedNormals[v * 2 + 0] = encoded[0];
+      packedNormals[v * 2 + 1] = encoded[1];
     }
+  });
 
-    std::memcpy(chunkMesh.indices, chunkIndices.data(),
-                chunkIndices.size() * sizeof(unsigned short));
-    UploadMesh(&chunkMesh, false);
-    meshes.push_back(chunkMesh);
-  }
-
-  if (meshes.empty()) {
-    return model;
-  }
-
-  model.transform = MatrixIdentity();
-  model.meshCount = static_cast<int>(meshes.size());
-  model.meshes = static_cast<Mesh *>(
-      MemAlloc(model.meshCount * sizeof(Mesh)));
-  for (int i = 0; i < model.meshCount; ++i) {
-    model.meshes[i] = meshes[i];
-  }
-  model.materialCount = 1;
-  model.materials = static_cast<Material *>(MemAlloc(sizeof(Material)));
-  model.materials[0] = LoadMaterialDefault();
-  model.meshMaterial = static_cast<int *>(
-      MemAlloc(model.meshCount * sizeof(int)));
-  for (int i = 0; i < model.meshCount; ++i) {
-    model.meshMaterial[i] = 0;
-  }
-
-  return model;
+  // Attribute slots match the names raylib binds in LoadShaderFromMemory.
+  mesh.vao = rlLoadVertexArray();
+  rlEnableVertexArray(mesh.vao);
+  mesh.positionVbo = rlLoadVertexBuffer(
+      packedPositions.data(),
+      static_cast<int>(packedPositions.size() * sizeof(uint16_t)), false);
+  rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, 3, GL_UNSIGNED_SHORT, true,
+                       4 * sizeof(uint16_t), 0);
+  rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
+  mesh.normalVbo = rlLoadVertexBuffer(
+      packedNormals.data(), static_cast<int>(packedNormals.size() * sizeof(int16_t)), false);
+  rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL, 2, GL_SHORT, true, 0, 0);
+  rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL);
+  // MeshGL's triVerts are already 32-bit, so they upload as-is.
+  mesh.indexVbo = rlLoadVertexBufferElement(
+      meshGL.triVerts.data(), static_cast<int>(meshGL.triVerts.size() * sizeof(uint32_t)),
+      false);
+  mesh.indexCount = static_cast<int>(meshGL.triVerts.size());
+  rlDisableVertexArray();
+  SetGpuMeshInstances(mesh, {});
+
+  return mesh;
 }
 
 void DrawAxes(float length) {
@@ -602,27 +684,6 @@ std::optional<std::filesystem::path> FindDefaultScene() {
 #endif
 }
 
-std::optional<std::string> ReadTextFile(const std::filesystem::path &path) {
-#ifdef __EMSCRIPTEN__
-  // Use Emscripten's virtual filesystem for web
-  FILE* file = fopen(path.string().c_str(), "r");
-  if (!file) return std::nullopt;
-  std::string content;
-  char buffer[4096];
-  while (fgets(buffer, sizeof(buffer), file)) {
-    content += buffer;
-  }
-  fclose(file);
-  return content;
-#else
-  std::ifstream file(path);
-  if (!file) return std::nullopt;
-  std::ostringstream ss;
-  ss << file.rdbuf();
-  return ss.str();
-#endif
-}
-
 // Track modules being loaded to prevent recursion
 static std::set<std::string> g_loading_modules;
 
@@ -666,224 +727,507 @@ JSModuleDef *DummyModuleLoader(JSContext *ctx, const char *module_name, void *op
   return nullptr;
 }
 
-JSModuleDef *FilesystemModuleLoader(JSContext *ctx, const char *module_name, void *opaque) {
-  auto *data = static_cast<ModuleLoaderData *>(opaque);
-  
-  // Ignore special inline module names that shouldn't go through the filesystem loader
-  // These are used for inline code evaluation and shouldn't trigger filesystem resolution
-  if (strncmp(module_name, "<", 1) == 0 || strncmp(module_name, "/dev/", 5) == 0) {
-    // This is an inline module (like <inline-scene>, <cmdline>, or /dev/stdin)
-    // QuickJS uses these for inline code and shouldn't try to load them via filesystem
-#ifdef __EMSCRIPTEN__
-    EM_ASM({
-      console.warn('⚠️ ModuleLoader called for inline module:', UTF8ToString($0), '- this should not happen during compilation');
-    }, module_name);
-#endif
-    JS_ThrowReferenceError(ctx, "Module '%s' is an inline module and cannot be loaded via filesystem", module_name);
-    return nullptr;
-  }
-  
-  std::filesystem::path resolved(module_name);
-  if (resolved.is_relative()) {
-    const std::filesystem::path base = data && !data->baseDir.empty()
-                                           ? data->baseDir
-                                           : std::filesystem::current_path();
-    resolved = base / resolved;
+// A piece of the scene uploaded as its own GpuMesh, keyed by a hash of its
+// geometry so a reload can keep the buffers of pieces it did not change.
+struct ScenePart {
+  uint64_t hash = 0;      // of the geometry only, not the instances
+  manifold::MeshGL mesh;  // positions only
+  std::vector<InstanceTransform> instances;  // empty: drawn once, in place
+};
+
+// Above this many connected components, components share GpuMeshes so the
+// draw count stays bounded.
+constexpr size_t kMaxSceneParts = 256;
+
+uint64_t HashWords(uint64_t hash, const void *data, size_t bytes) {
+  const auto *words = static_cast<const uint32_t *>(data);
+  for (size_t i = 0; i < bytes / sizeof(uint32_t); ++i) {
+    hash = (hash ^ words[i]) * 0x100000001b3ull;
   }
-  resolved = std::filesystem::absolute(resolved).lexically_normal();
+  return hash;
+}
 
-#ifdef __EMSCRIPTEN__
-  EM_ASM({
-    console.log('📦 ModuleLoader called for:', UTF8ToString($0));
-    console.log('📦 Current dependencies count:', $1);
-  }, resolved.string().c_str(), data ? data->dependencies.size() : 0);
-#endif
+uint64_t HashPartMesh(const manifold::MeshGL &mesh) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  hash = HashWords(hash, mesh.vertProperties.data(), mesh.vertProperties.size() * sizeof(float));
+  return HashWords(hash, mesh.triVerts.data(), mesh.triVerts.size() * sizeof(uint32_t));
+}
 
-  // Check for circular dependency to prevent stack overflow
-  if (data && data->dependencies.find(resolved) != data->dependencies.end()) {
-#ifdef __EMSCRIPTEN__
-    EM_ASM({
-      console.error('⚠️ Circular dependency detected:', UTF8ToString($0));
-    }, resolved.string().c_str());
-#endif
-    JS_ThrowReferenceError(ctx, "Circular dependency detected: module '%s' is already being loaded", resolved.string().c_str());
-    return nullptr;
+// Splits the scene into its connected components, numbered by their first
+// triangle so unchanged components keep their place across reloads. With more
+// than kMaxSceneParts components, they are bucketed by hash: an edit then
+// only touches the buckets of the components it changed.
+std::vector<ScenePart> SplitSceneParts(const manifold::MeshGL &meshGL) {
+  const size_t numVert = meshGL.NumVert();
+  const size_t numTri = meshGL.NumTri();
+  std::vector<uint32_t> parent(numVert);
+  for (size_t v = 0; v < numVert; ++v) parent[v] = static_cast<uint32_t>(v);
+  auto find = [&](uint32_t v) {
+    while (parent[v] != v) {
+      parent[v] = parent[parent[v]];
+      v = parent[v];
+    }
+    return v;
+  };
+  auto unite = [&](uint32_t a, uint32_t b) {
+    a = find(a);
+    b = find(b);
+    if (a != b) parent[std::max(a, b)] = std::min(a, b);
+  };
+  for (size_t tri = 0; tri < numTri; ++tri) {
+    unite(meshGL.triVerts[tri * 3], meshGL.triVerts[tri * 3 + 1]);
+    unite(meshGL.triVerts[tri * 3], meshGL.triVerts[tri * 3 + 2]);
+  }
+  for (size_t i = 0; i < meshGL.mergeFromVert.size(); ++i) {
+    unite(meshGL.mergeFromVert[i], meshGL.mergeToVert[i]);
   }
 
-  if (data) {
-    data->baseDir = resolved.parent_path();
-    data->dependencies.insert(resolved);
+  std::vector<int> componentOf(numVert, -1);
+  std::vector<std::vector<uint32_t>> componentTris;
+  for (size_t tri = 0; tri < numTri; ++tri) {
+    const uint32_t root = find(meshGL.triVerts[tri * 3]);
+    if (componentOf[root] < 0) {
+      componentOf[root] = static_cast<int>(componentTris.size());
+      componentTris.emplace_back();
+    }
+    componentTris[componentOf[root]].push_back(static_cast<uint32_t>(tri));
+  }
+
+  // Components share no vertices, so one remap table serves them all.
+  std::vector<ScenePart> components(componentTris.size());
+  std::vector<int> local(numVert, -1);
+  const size_t stride = meshGL.numProp;
+  for (size_t c = 0; c < components.size(); ++c) {
+    manifold::MeshGL &mesh = components[c].mesh;
+    mesh.numProp = 3;
+    mesh.triVerts.reserve(componentTris[c].size() * 3);
+    for (uint32_t tri : componentTris[c]) {
+      for (int j = 0; j < 3; ++j) {
+        const uint32_t vert = meshGL.triVerts[tri * 3 + j];
+        if (local[vert] < 0) {
+          local[vert] = static_cast<int>(mesh.NumVert());
+          mesh.vertProperties.insert(mesh.vertProperties.end(),
+                                     meshGL.vertProperties.begin() + vert * stride,
+                                     meshGL.vertProperties.begin() + vert * stride + 3);
+        }
+        mesh.triVerts.push_back(static_cast<uint32_t>(local[vert]));
+      }
+    }
+    components[c].hash = HashPartMesh(mesh);
+  }
+  if (components.size() <= kMaxSceneParts) return components;
+
+  std::vector<ScenePart> buckets(kMaxSceneParts);
+  for (auto &component : components) {
+    ScenePart &bucket = buckets[component.hash % kMaxSceneParts];
+    const auto firstVert = static_cast<uint32_t>(bucket.mesh.NumVert());
+    bucket.mesh.numProp = 3;
+    bucket.mesh.vertProperties.insert(bucket.mesh.vertProperties.end(),
+                                      component.mesh.vertProperties.begin(),
+                                      component.mesh.vertProperties.end());
+    for (uint32_t vert : component.mesh.triVerts) {
+      bucket.mesh.triVerts.push_back(firstVert + vert);
+    }
+    bucket.hash = HashWords(bucket.hash ^ 0x9e3779b97f4a7c15ull, &component.hash,
+                            sizeof(component.hash));
   }
+  buckets.erase(std::remove_if(buckets.begin(), buckets.end(),
+                               [](const ScenePart &part) { return part.mesh.NumTri() == 0; }),
+                buckets.end());
+  return buckets;
+}
 
-  auto source = ReadTextFile(resolved);
-  if (!source) {
-    JS_ThrowReferenceError(ctx, "Unable to load module '%s'", resolved.string().c_str());
-    if (data) {
-      data->dependencies.erase(resolved);
+// Model matrix of a placement, converted like vertex positions: from the
+// scene's Z-up millimetres to the renderer's Y-up units.
+InstanceTransform ToInstanceTransform(const manifold::mat3x4 &m) {
+  // Renderer axis i is scene axis kAxis[i], times kSign[i].
+  constexpr int kAxis[3] = {0, 2, 1};
+  constexpr float kSign[3] = {1.0f, 1.0f, -1.0f};
+  InstanceTransform out{};
+  manifold::vec3 columns[3];
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 3; ++row) {
+      columns[col][row] = kSign[row] * kSign[col] * m[kAxis[col]][kAxis[row]];
+      out.model[col * 4 + row] = static_cast<float>(columns[col][row]);
     }
-    return nullptr;
   }
+  for (int row = 0; row < 3; ++row) {
+    out.model[12 + row] = kSign[row] * static_cast<float>(m[3][kAxis[row]]) * kSceneScale;
+  }
+  out.model[15] = 1.0f;
+
+  // Inverse-transpose of the linear part: its columns are the cross products
+  // of the other two columns, over the determinant. The shaders normalize, so
+  // a singular matrix just keeps the unscaled cofactors.
+  const manifold::vec3 cofactors[3] = {manifold::la::cross(columns[1], columns[2]),
+                                       manifold::la::cross(columns[2], columns[0]),
+                                       manifold::la::cross(columns[0], columns[1])};
+  const double det = manifold::la::dot(columns[0], cofactors[0]);
+  const double invDet = det != 0.0 ? 1.0 / det : 1.0;
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 3; ++row) {
+      out.normal[col * 3 + row] = static_cast<float>(cofactors[col][row] * invDet);
+    }
+  }
+  return out;
+}
+
+// One part per distinct placed geometry, with an instance per placement.
+// Copies built separately share a part when their meshes are identical.
+std::vector<ScenePart> PlacementParts(const std::vector<ScenePlacement> &placements) {
+  std::vector<ScenePart> parts;
+  std::unordered_map<const manifold::Manifold *, size_t> byManifold;
+  std::unordered_map<uint64_t, size_t> byHash;
+  for (const auto &placement : placements) {
+    auto it = byManifold.find(placement.manifold.get());
+    if (it == byManifold.end()) {
+      const manifold::MeshGL meshGL = placement.manifold->GetMeshGL();
+      ScenePart part;
+      part.mesh.numProp = 3;
+      part.mesh.vertProperties.resize(static_cast<size_t>(meshGL.NumVert()) * 3);
+      for (size_t v = 0; v < meshGL.NumVert(); ++v) {
+        for (int axis = 0; axis < 3; ++axis) {
+          part.mesh.vertProperties[v * 3 + axis] = meshGL.vertProperties[v * meshGL.numProp + axis];
+        }
+      }
+      part.mesh.triVerts = meshGL.triVerts;
+      part.hash = HashPartMesh(part.mesh);
+      auto same = byHash.find(part.hash);
+      if (same == byHash.end()) {
+        same = byHash.emplace(part.hash, parts.size()).first;
+        parts.push_back(std::move(part));
+      }
+      it = byManifold.emplace(placement.manifold.get(), same->second).first;
+    }
+    parts[it->second].instances.push_back(ToInstanceTransform(placement.transform));
+  }
+  return parts;
+}
 
-  const std::string moduleName = resolved.string();
-  
-#ifdef __EMSCRIPTEN__
-  EM_ASM({
-    console.log('🔨 Compiling module in loader:', UTF8ToString($0), 'size:', $1);
-  }, moduleName.c_str(), source->size());
-#endif
-  
-  JSValue funcVal = JS_Eval(ctx, source->c_str(), source->size(), moduleName.c_str(),
-                            JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY);
-  if (JS_IsException(funcVal)) {
-#ifdef __EMSCRIPTEN__
-    EM_ASM({
-      console.error('❌ Module compilation failed in loader:', UTF8ToString($0));
-    }, moduleName.c_str());
-#endif
-    if (data) {
-      data->dependencies.erase(resolved);
+// Uploads the parts whose hash is not already on the GPU and frees the
+// GpuMeshes no part uses any more. Kept meshes only get new instances.
+void ReplaceScene(GpuScene &model, const std::vector<ScenePart> &parts) {
+  std::unordered_multimap<uint64_t, size_t> uploaded;
+  for (size_t i = 0; i < model.size(); ++i) {
+    uploaded.emplace(model[i].contentHash, i);
+  }
+  std::vector<bool> kept(model.size(), false);
+  GpuScene next;
+  next.reserve(parts.size());
+  size_t created = 0;
+  for (const auto &part : parts) {
+    auto it = uploaded.find(part.hash);
+    if (it != uploaded.end()) {
+      kept[it->second] = true;
+      next.push_back(model[it->second]);
+      SetGpuMeshInstances(next.back(), part.instances);
+      uploaded.erase(it);
+      continue;
     }
-    return nullptr;
+    GpuMesh mesh = CreateGpuMesh(part.mesh);
+    mesh.contentHash = part.hash;
+    SetGpuMeshInstances(mesh, part.instances);
+    next.push_back(mesh);
+    ++created;
+  }
+  for (size_t i = 0; i < model.size(); ++i) {
+    if (!kept[i]) DestroyGpuMesh(model[i]);
   }
+  model = std::move(next);
+  TraceLog(LOG_INFO, "Scene: %zu parts, %zu uploaded", parts.size(), created);
+}
 
-  auto *module = static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(funcVal));
-  JS_FreeValue(ctx, funcVal);
-  
-#ifdef __EMSCRIPTEN__
-  EM_ASM({
-    console.log('✅ Module loaded successfully:', UTF8ToString($0));
-  }, moduleName.c_str());
-#endif
-  
-  return module;
+bool ReplaceScene(GpuScene &model, const std::shared_ptr<manifold::Manifold> &scene,
+                  const std::vector<ScenePlacement> &placements = {}) {
+  if (!scene) return false;
+  ReplaceScene(model, placements.empty() ? SplitSceneParts(scene->GetMeshGL())
+                                         : PlacementParts(placements));
+  return true;
 }
 
-struct LoadResult {
-  bool success = false;
-  std::shared_ptr<manifold::Manifold> manifold;
-  std::string message;
-  std::vector<std::filesystem::path> dependencies;
+#ifndef __EMSCRIPTEN__
+// A finished evaluation, handed from the worker to the render thread.
+struct SceneUpdate {
+  LoadResult load;
+  std::shared_ptr<const manifold::MeshGL> mesh;
+  std::vector<ScenePart> parts;
+  EvalQuality quality = EvalQuality::Full;
 };
 
-LoadResult LoadSceneFromFile(JSRuntime *runtime, const std::filesystem::path &path) {
-  LoadResult result;
-  const auto absolutePath = std::filesystem::absolute(path);
-  if (!std::filesystem::exists(absolutePath)) {
-    result.message = "Scene file not found: " + absolutePath.string();
-    return result;
-  }
-  g_module_loader_data.baseDir = absolutePath.parent_path();
-  g_module_loader_data.dependencies.clear();
-  g_module_loader_data.dependencies.insert(absolutePath);
-  auto sourceOpt = ReadTextFile(absolutePath);
-  if (!sourceOpt) {
-    result.message = "Unable to read scene file: " + absolutePath.string();
-    result.dependencies.assign(g_module_loader_data.dependencies.begin(),
-                               g_module_loader_data.dependencies.end());
-    return result;
+// Evaluates scene scripts on a background thread with its own JSRuntime, so
+// the render loop keeps drawing (and orbiting) the previous model while a
+// reload runs. A newer Request() interrupts the script in flight; finished
+// results land in a single-slot mailbox that the render thread polls.
+class SceneWorker {
+ public:
+  SceneWorker() : thread_([this]() { Run(); }) {}
+
+  ~SceneWorker() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+      requested_.fetch_add(1);  // interrupt whatever is running
+    }
+    wake_.notify_one();
+    thread_.join();
+    delete mailbox_.exchange(nullptr);
   }
-  JSContext *ctx = JS_NewContext(runtime);
-  RegisterBindings(ctx);
 
-  auto captureException = [&]() {
-    JSValue exc = JS_GetException(ctx);
-    JSValue stack = JS_GetPropertyStr(ctx, exc, "stack");
-    const char *stackStr = JS_ToCString(ctx, JS_IsUndefined(stack) ? exc : stack);
-    result.message = stackStr ? stackStr : "JavaScript error";
-    JS_FreeCString(ctx, stackStr);
-    JS_FreeValue(ctx, stack);
-    JS_FreeValue(ctx, exc);
-  };
-  auto assignDependencies = [&]() {
-    result.dependencies.assign(g_module_loader_data.dependencies.begin(),
-                               g_module_loader_data.dependencies.end());
-  };
+  SceneWorker(const SceneWorker &) = delete;
+  SceneWorker &operator=(const SceneWorker &) = delete;
 
-  JSValue moduleFunc = JS_Eval(ctx, sourceOpt->c_str(), sourceOpt->size(), absolutePath.string().c_str(),
-                               JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY);
-  if (JS_IsException(moduleFunc)) {
-    captureException();
-    assignDependencies();
-    JS_FreeContext(ctx);
-    return result;
+  void Request(const std::filesystem::path &path, EvalQuality quality) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pendingPath_ = path;
+      pendingQuality_ = quality;
+      hasPending_ = true;
+      requested_.fetch_add(1);
+    }
+    wake_.notify_one();
+  }
+
+  // Takes the newest finished evaluation, if one arrived since the last call.
+  std::unique_ptr<SceneUpdate> Poll() {
+    return std::unique_ptr<SceneUpdate>(mailbox_.exchange(nullptr, std::memory_order_acquire));
+  }
+
+ private:
+  void Run() {
+    JSRuntime *runtime = JS_NewRuntime();
+    // Runs on a ScriptThread, so scripts get QuickJS's usual stack limit.
+    JS_SetMaxStackSize(runtime, kScriptStackLimit);
+    EnsureManifoldClass(runtime);
+    JS_SetModuleLoaderFunc(runtime, NormalizeModuleName, FilesystemModuleLoader,
+                           &g_module_loader_data);
+    JS_SetInterruptHandler(runtime, &SceneWorker::InterruptIfSuperseded, this);
+
+    EvalQuality lastQuality = EvalQuality::Full;
+    for (;;) {
+      std::filesystem::path path;
+      EvalQuality quality = EvalQuality::Full;
+      uint64_t generation = 0;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this]() { return stopping_ || hasPending_; });
+        if (stopping_) break;
+        path = pendingPath_;
+        quality = pendingQuality_;
+        hasPending_ = false;
+        generation = requested_.load();
+      }
+      running_.store(generation);
+
+      auto update = std::make_unique<SceneUpdate>();
+      update->quality = quality;
+      if (quality != lastQuality) {
+        // "use cache" modules built their geometry at the old quality.
+        ReleaseSceneContext(g_module_loader_data);
+        SetEvalQuality(runtime, quality);
+        lastQuality = quality;
+      }
+      update->load = LoadSceneFromFile(runtime, g_module_loader_data, path);
+      if (update->load.success) {
+        update->mesh =
+            std::make_shared<const manifold::MeshGL>(update->load.manifold->GetMeshGL());
+        update->parts = update->load.placements.empty()
+                            ? SplitSceneParts(*update->mesh)
+                            : PlacementParts(update->load.placements);
+      }
+      if (generation != requested_.load()) continue;  // a newer save is queued
+      delete mailbox_.exchange(update.release(), std::memory_order_acq_rel);
+    }
+
+    ReleaseSceneContext(g_module_loader_data);
+    FreeBindingState(runtime);
+    JS_FreeRuntime(runtime);
   }
 
-  if (JS_ResolveModule(ctx, moduleFunc) < 0) {
-    captureException();
-    JS_FreeValue(ctx, moduleFunc);
-    assignDependencies();
-    JS_FreeContext(ctx);
-    return result;
+  static int InterruptIfSuperseded(JSRuntime *, void *opaque) {
+    auto *self = static_cast<SceneWorker *>(opaque);
+    return self->running_.load(std::memory_order_relaxed) !=
+           self->requested_.load(std::memory_order_relaxed);
   }
 
-  auto *module = static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(moduleFunc));
-  JSValue evalResult = JS_EvalFunction(ctx, moduleFunc);
-  if (JS_IsException(evalResult)) {
-    captureException();
-    assignDependencies();
-    JS_FreeContext(ctx);
-    return result;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::filesystem::path pendingPath_;
+  EvalQuality pendingQuality_ = EvalQuality::Full;
+  bool hasPending_ = false;
+  bool stopping_ = false;
+  std::atomic<uint64_t> requested_{0};
+  std::atomic<uint64_t> running_{0};
+  std::atomic<SceneUpdate *> mailbox_{nullptr};
+  ScriptThread thread_;  // last, so it starts after the members above
+};
+
+// Writes exports on a background thread so large meshes do not stall the
+// render loop. The loop polls Progress() for the status line and TakeResult()
+// for the final message. One export runs at a time.
+class ExportWorker {
+ public:
+  ExportWorker() = default;
+  ~ExportWorker() {
+    if (thread_.joinable()) thread_.join();
+  }
+
+  ExportWorker(const ExportWorker &) = delete;
+  ExportWorker &operator=(const ExportWorker &) = delete;
+
+  bool Running() const { return running_.load(std::memory_order_acquire); }
+  float Progress() const { return progress_.load(std::memory_order_relaxed); }
+
+  void Start(std::shared_ptr<const manifold::MeshGL> mesh, std::filesystem::path path) {
+    if (thread_.joinable()) thread_.join();
+    progress_.store(0.0f);
+    running_.store(true);
+    thread_ = std::thread([this, mesh = std::move(mesh), path = std::move(path)]() {
+      std::string error;
+      const bool ok = WriteMeshFile(
+          *mesh, path, error, [this](float done) { progress_.store(done, std::memory_order_relaxed); });
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result_ = ok ? "Saved " + path.string() : error;
+      }
+      running_.store(false, std::memory_order_release);
+    });
   }
-  JS_FreeValue(ctx, evalResult);
 
-  JSValue moduleNamespace = JS_GetModuleNamespace(ctx, module);
-  if (JS_IsException(moduleNamespace)) {
-    captureException();
-    assignDependencies();
-    JS_FreeContext(ctx);
+  std::optional<std::string> TakeResult() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto result = std::move(result_);
+    result_.reset();
     return result;
   }
 
-  JSValue sceneVal = JS_GetPropertyStr(ctx, moduleNamespace, "scene");
-  if (JS_IsException(sceneVal)) {
-    JS_FreeValue(ctx, moduleNamespace);
-    captureException();
-    assignDependencies();
-    JS_FreeContext(ctx);
-    return result;
+ private:
+  std::mutex mutex_;
+  std::optional<std::string> result_;
+  std::atomic<bool> running_{false};
+  std::atomic<float> progress_{0.0f};
+  std::thread thread_;
+};
+#endif
+
+#ifdef __linux__
+// Watches the scene's dependency set with inotify. Directories are watched
+// rather than files so editors that save by rename are still seen; a burst of
+// events is coalesced over a short debounce window before it counts as one
+// change. The render loop only reads an atomic flag, so idle frames cost no
+// syscalls at all.
+class FileWatcher {
+ public:
+  FileWatcher()
+      : inotifyFd_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)),
+        stopFd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+    if (inotifyFd_ < 0 || stopFd_ < 0) {
+      TraceLog(LOG_WARNING, "inotify unavailable, file watching disabled");
+      return;
+    }
+    thread_ = std::thread([this]() { Run(); });
   }
-  JS_FreeValue(ctx, moduleNamespace);
 
-  if (JS_IsUndefined(sceneVal)) {
-    JS_FreeValue(ctx, sceneVal);
-    JS_FreeContext(ctx);
-    result.message = "Scene module must export 'scene'";
-    assignDependencies();
-    return result;
+  ~FileWatcher() {
+    if (thread_.joinable()) {
+      const uint64_t one = 1;
+      (void)!write(stopFd_, &one, sizeof(one));
+      thread_.join();
+    }
+    if (inotifyFd_ >= 0) close(inotifyFd_);
+    if (stopFd_ >= 0) close(stopFd_);
+  }
+
+  FileWatcher(const FileWatcher &) = delete;
+  FileWatcher &operator=(const FileWatcher &) = delete;
+
+  void SetFiles(const std::vector<std::filesystem::path> &files) {
+    if (inotifyFd_ < 0) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.clear();
+    std::set<std::filesystem::path> dirs;
+    for (const auto &file : files) {
+      const auto normal = file.lexically_normal();
+      files_.insert(normal);
+      dirs.insert(normal.parent_path());
+    }
+    for (auto it = watches_.begin(); it != watches_.end();) {
+      if (dirs.count(it->second) == 0) {
+        inotify_rm_watch(inotifyFd_, it->first);
+        it = watches_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    constexpr uint32_t kMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM |
+                               IN_CREATE | IN_DELETE;
+    for (const auto &dir : dirs) {
+      const int wd = inotify_add_watch(inotifyFd_, dir.c_str(), kMask);
+      if (wd >= 0) watches_[wd] = dir;
+    }
   }
 
-  auto sceneHandle = GetManifoldHandle(ctx, sceneVal);
-  if (!sceneHandle) {
-    JS_FreeValue(ctx, sceneVal);
-    JS_FreeContext(ctx);
-    result.message = "Exported 'scene' is not a manifold";
-    assignDependencies();
-    return result;
+  // True once per debounced burst of changes to a watched file.
+  bool TakeChange() { return changed_.exchange(false, std::memory_order_acq_rel); }
+
+ private:
+  static constexpr int kDebounceMs = 75;
+
+  void Run() {
+    pollfd fds[2] = {{inotifyFd_, POLLIN, 0}, {stopFd_, POLLIN, 0}};
+    bool pending = false;
+    for (;;) {
+      // Block until something happens; once a change is seen, wait for the
+      // burst to go quiet before reporting it.
+      const int ready = poll(fds, 2, pending ? kDebounceMs : -1);
+      if (ready < 0) {
+        if (errno == EINTR) continue;
+        break;
+      }
+      if (fds[1].revents & POLLIN) break;
+      if (ready == 0) {
+        pending = false;
+        changed_.store(true, std::memory_order_release);
+        continue;
+      }
+      if (DrainEvents()) pending = true;
+    }
   }
 
-  result.manifold = sceneHandle;
-  result.success = true;
-  result.message = "Loaded " + absolutePath.string();
-  assignDependencies();
-  JS_FreeValue(ctx, sceneVal);
-  JS_FreeContext(ctx);
-  return result;
-}
+  // Reads every queued event; returns true if any touched a watched file.
+  bool DrainEvents() {
+    alignas(inotify_event) char buffer[4096];
+    bool relevant = false;
+    for (;;) {
+      const ssize_t len = read(inotifyFd_, buffer, sizeof(buffer));
+      if (len <= 0) break;
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (ssize_t offset = 0; offset < len;) {
+        const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+        offset += sizeof(inotify_event) + event->len;
+        if (event->len == 0) continue;
+        auto dir = watches_.find(event->wd);
+        if (dir == watches_.end()) continue;
+        if (files_.count(dir->second / event->name) != 0) relevant = true;
+      }
+    }
+    return relevant;
+  }
 
-bool ReplaceScene(Model &model,
-                  const std::shared_ptr<manifold::Manifold> &scene) {
-  if (!scene) return false;
-  Model newModel = CreateRaylibModelFrom(scene->GetMeshGL());
-  DestroyModel(model);
-  model = newModel;
-  return true;
-}
+  int inotifyFd_ = -1;
+  int stopFd_ = -1;
+  std::mutex mutex_;
+  std::set<std::filesystem::path> files_;
+  std::unordered_map<int, std::filesystem::path> watches_;
+  std::atomic<bool> changed_{false};
+  std::thread thread_;
+};
+#endif
 
 // Global state for runtime scene loading (used by Emscripten exports)
 struct GlobalState {
   JSRuntime *runtime = nullptr;
   std::shared_ptr<manifold::Manifold> *scene = nullptr;
-  Model *model = nullptr;
+  GpuScene *model = nullptr;
   std::string *statusMessage = nullptr;
   // Camera state pointers
   Camera3D *camera = nullptr;
@@ -1233,7 +1577,18 @@ LoadResult LoadSceneFromCode(JSRuntime *runtime, const std::string &code) {
     console.log('🔨 Step 6: Converting scene value to manifold');
   });
 #endif
-  auto sceneHandle = GetManifoldHandle(ctx, sceneVal);
+  std::shared_ptr<manifold::Manifold> sceneHandle;
+  if (JS_IsArray(sceneVal)) {
+    if (!GetScenePlacements(ctx, sceneVal, result.placements)) {
+      JS_FreeValue(ctx, sceneVal);
+      captureException("Step 6: Invalid scene placements");
+      JS_FreeContext(ctx);
+      return result;
+    }
+    sceneHandle = ComposePlacements(result.placements);
+  } else {
+    sceneHandle = GetManifoldHandle(ctx, sceneVal);
+  }
   if (!sceneHandle) {
     // Get type information for better error message
     int tag = JS_VALUE_GET_TAG(sceneVal);
@@ -1284,6 +1639,7 @@ LoadResult LoadSceneFromCode(JSRuntime *runtime, const std::string &code) {
   result.manifold = sceneHandle;
   result.success = true;
   result.message = "Scene loaded successfully";
+  SweepGeometryCache(runtime);
   JS_FreeValue(ctx, sceneVal);
   JS_FreeContext(ctx);
   return result;
@@ -1340,7 +1696,7 @@ void loadSceneFromCode(const char* code) {
     }
     
     *g_state.scene = load.manifold;
-    bool replaced = ReplaceScene(*g_state.model, *g_state.scene);
+    bool replaced = ReplaceScene(*g_state.model, *g_state.scene, load.placements);
     if (!replaced) {
       *g_state.statusMessage = "Error: Failed to replace model with new scene";
       EM_ASM({
@@ -1605,11 +1961,27 @@ int main() {
   float initialYaw = orbitYaw;
   float initialPitch = orbitPitch;
 
+#ifdef __EMSCRIPTEN__
   JSRuntime *runtime = JS_NewRuntime();
   EnsureManifoldClass(runtime);
   JS_SetModuleLoaderFunc(runtime, nullptr, FilesystemModuleLoader, &g_module_loader_data);
+#else
+  // Desktop scenes are evaluated off the render thread.
+  SceneWorker sceneWorker;
+  std::shared_ptr<const manifold::MeshGL> sceneMesh;
+  ExportWorker exportWorker;
+  // Reloads are evaluated at preview quality (F toggles); the full-quality
+  // model follows once the preview has been on screen for kFullQualityDelay
+  // seconds without another edit, and P waits for it before exporting.
+  constexpr double kFullQualityDelay = 1.5;
+  bool previewReloads = true;
+  EvalQuality shownQuality = EvalQuality::Full;
+  double fullQualityDueAt = -1.0;
+  bool exportAfterFull = false;
+#endif
 
   std::shared_ptr<manifold::Manifold> scene = nullptr;
+  std::vector<ScenePlacement> initialPlacements;  // web: from the synchronous first load
   
 #ifdef __EMSCRIPTEN__
   // Setup global state for Emscripten exports
@@ -1618,7 +1990,11 @@ int main() {
 #endif
   std::string statusMessage;
   std::filesystem::path scriptPath;
+#ifdef __linux__
+  FileWatcher fileWatcher;
+#else
   std::unordered_map<std::filesystem::path, WatchedFile> watchedFiles;
+#endif
   auto defaultScript = FindDefaultScene();
   auto reportStatus = [&](const std::string &message) {
     statusMessage = message;
@@ -1626,6 +2002,9 @@ int main() {
     std::cout << statusMessage << std::endl;
   };
   auto setWatchedFiles = [&](const std::vector<std::filesystem::path> &deps) {
+#ifdef __linux__
+    fileWatcher.SetFiles(deps);
+#else
     std::unordered_map<std::filesystem::path, WatchedFile> updated;
     for (const auto &dep : deps) {
       WatchedFile entry;
@@ -1637,13 +2016,16 @@ int main() {
       updated.emplace(dep, entry);
     }
     watchedFiles = std::move(updated);
+#endif
   };
   bool isFirstLoad = true;
   if (defaultScript) {
     scriptPath = std::filesystem::absolute(*defaultScript);
-    auto load = LoadSceneFromFile(runtime, scriptPath);
+#ifdef __EMSCRIPTEN__
+    auto load = LoadSceneFromFile(runtime, g_module_loader_data, scriptPath);
     if (load.success) {
       scene = load.manifold;
+      initialPlacements = load.placements;
       reportStatus(load.message);
     } else {
       reportStatus(load.message);
@@ -1651,6 +2033,10 @@ int main() {
     if (!load.dependencies.empty()) {
       setWatchedFiles(load.dependencies);
     }
+#else
+    sceneWorker.Request(scriptPath, EvalQuality::Full);
+    reportStatus("Loading " + scriptPath.string());
+#endif
   }
   if (!scene) {
     // Create empty scene (tiny invisible cube) instead of default logo
@@ -1663,7 +2049,13 @@ int main() {
     }
   }
 
-  Model model = CreateRaylibModelFrom(scene->GetMeshGL());
+  GpuScene model;
+#ifdef __EMSCRIPTEN__
+  ReplaceScene(model, scene, initialPlacements);
+#else
+  sceneMesh = std::make_shared<const manifold::MeshGL>(scene->GetMeshGL());
+  ReplaceScene(model, SplitSceneParts(*sceneMesh));
+#endif
 
 #ifdef __EMSCRIPTEN__
   // Complete global state setup
@@ -1691,8 +2083,11 @@ int main() {
 
   if (outlineShader.id == 0 || toonShader.id == 0 || normalDepthShader.id == 0 || edgeShader.id == 0) {
     TraceLog(LOG_ERROR, "Failed to load one or more shaders.");
-    DestroyModel(model);
+    DestroyGpuScene(model);
+#ifdef __EMSCRIPTEN__
+    FreeBindingState(runtime);
     JS_FreeRuntime(runtime);
+#endif
     CloseWindow();
     return 1;
   }
@@ -1803,10 +2198,11 @@ int main() {
     const Vector2 mouseDelta = GetMouseDelta();
 
     auto reloadScene = [&]() {
-      auto load = LoadSceneFromFile(runtime, scriptPath);
+#ifdef __EMSCRIPTEN__
+      auto load = LoadSceneFromFile(runtime, g_module_loader_data, scriptPath);
       if (load.success) {
         scene = load.manifold;
-        ReplaceScene(model, scene);
+        ReplaceScene(model, scene, load.placements);
         reportStatus(load.message);
       } else {
         reportStatus(load.message);
@@ -1814,30 +2210,116 @@ int main() {
       if (!load.dependencies.empty()) {
         setWatchedFiles(load.dependencies);
       }
+#else
+      // The current model stays on screen until the worker posts a result.
+      sceneWorker.Request(scriptPath, previewReloads ? EvalQuality::Preview : EvalQuality::Full);
+      fullQualityDueAt = -1.0;
+#endif
     };
 
 #ifndef __EMSCRIPTEN__
+    auto exportScene = [&]() {
+      std::filesystem::path downloads;
+      if (const char *home = std::getenv("HOME")) {
+        downloads = std::filesystem::path(home) / "Downloads";
+      } else {
+        downloads = std::filesystem::current_path();
+      }
+
+      std::error_code dirErr;
+      std::filesystem::create_directories(downloads, dirErr);
+      if (dirErr && !std::filesystem::exists(downloads)) {
+        reportStatus("Export failed: cannot access " + downloads.string());
+        return;
+      }
+      // DINGCAD_EXPORT_FORMAT picks stl (default), 3mf, ply or obj.
+      const char *formatEnv = std::getenv("DINGCAD_EXPORT_FORMAT");
+      std::string format = formatEnv && *formatEnv ? formatEnv : "stl";
+      std::transform(format.begin(), format.end(), format.begin(),
+                     [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+      if (format != "stl" && format != "3mf" && format != "ply" && format != "obj") {
+        reportStatus("Export failed: DINGCAD_EXPORT_FORMAT must be stl, 3mf, ply or obj, not \"" +
+                     format + "\"");
+        return;
+      }
+      std::filesystem::path savePath = downloads / ("ding." + format);
+      TraceLog(LOG_INFO, "Export path: %s", savePath.string().c_str());
+      if (exportWorker.Running()) {
+        reportStatus("Export already in progress");
+      } else {
+        exportWorker.Start(sceneMesh, savePath);
+      }
+    };
+
+    if (exportWorker.Running()) {
+      statusMessage = "Exporting... " +
+                      std::to_string(static_cast<int>(exportWorker.Progress() * 100.0f)) + "%";
+    } else if (auto result = exportWorker.TakeResult()) {
+      reportStatus(*result);
+    }
+
+    if (auto update = sceneWorker.Poll()) {
+      if (update->load.success) {
+        scene = update->load.manifold;
+        sceneMesh = std::move(update->mesh);
+        shownQuality = update->quality;
+        ReplaceScene(model, update->parts);
+      }
+      reportStatus(update->load.message);
+      if (!update->load.dependencies.empty()) {
+        setWatchedFiles(update->load.dependencies);
+      }
+      if (update->load.success && shownQuality == EvalQuality::Preview) {
+        fullQualityDueAt = GetTime() + kFullQualityDelay;
+      }
+      if (exportAfterFull && update->quality == EvalQuality::Full) {
+        exportAfterFull = false;
+        if (update->load.success) exportScene();
+      }
+    }
+
+    if (fullQualityDueAt >= 0.0 && GetTime() >= fullQualityDueAt) {
+      fullQualityDueAt = -1.0;
+      sceneWorker.Request(scriptPath, EvalQuality::Full);
+    }
+
+    if (IsKeyPressed(KEY_F) && !scriptPath.empty()) {
+      previewReloads = !previewReloads;
+      reportStatus(previewReloads ? "Preview quality on reload" : "Full quality on reload");
+      if (!previewReloads && shownQuality == EvalQuality::Preview) {
+        fullQualityDueAt = GetTime();
+      }
+    }
+
     // File watching only works on desktop, not in browser
-    if (!scriptPath.empty()) {
+#ifdef __linux__
+    if (!scriptPath.empty() && fileWatcher.TakeChange()) {
+      reloadScene();
+    }
+#else
+    // Without inotify, stat the dependencies a few times a second rather
+    // than on every frame.
+    constexpr double kWatchPollInterval = 0.25;
+    static double lastWatchPoll = 0.0;
+    if (!scriptPath.empty() && GetTime() - lastWatchPoll >= kWatchPollInterval) {
+      lastWatchPoll = GetTime();
       bool changed = false;
-      for (const auto &entry : watchedFiles) {
+      for (auto &entry : watchedFiles) {
         std::error_code ec;
         auto currentTs = std::filesystem::last_write_time(entry.first, ec);
-        if (ec) {
-          if (entry.second.timestamp.has_value()) {
-            changed = true;
-            break;
-          }
-        } else if (!entry.second.timestamp.has_value() ||
-                   currentTs != *entry.second.timestamp) {
+        std::optional<std::filesystem::file_time_type> seen;
+        if (!ec) seen = currentTs;
+        if (seen != entry.second.timestamp) {
+          // Record it now so the pending reload is not requested every frame.
+          entry.second.timestamp = seen;
           changed = true;
-          break;
         }
       }
       if (changed) {
         reloadScene();
       }
     }
+#endif  // __linux__
 #endif
 
     if (IsKeyPressed(KEY_R) && !scriptPath.empty()) {
@@ -1905,27 +2387,14 @@ int main() {
           reportStatus(error);
         }
 #else
-        std::filesystem::path downloads;
-        if (const char *home = std::getenv("HOME")) {
-          downloads = std::filesystem::path(home) / "Downloads";
-        } else {
-          downloads = std::filesystem::current_path();
-        }
-
-        std::error_code dirErr;
-        std::filesystem::create_directories(downloads, dirErr);
-        if (dirErr && !std::filesystem::exists(downloads)) {
-          reportStatus("Export failed: cannot access " + downloads.string());
+        if (shownQuality == EvalQuality::Preview) {
+          // Exports are always full quality; the export starts when it lands.
+          exportAfterFull = true;
+          fullQualityDueAt = -1.0;
+          sceneWorker.Request(scriptPath, EvalQuality::Full);
+          reportStatus("Evaluating full quality for export...");
         } else {
-          std::filesystem::path savePath = downloads / "ding.stl";
-          std::string error;
-          const bool ok = WriteMeshAsBinaryStl(scene->GetMeshGL(), savePath, error);
-          TraceLog(LOG_INFO, "Export path: %s", savePath.string().c_str());
-          if (ok) {
-            reportStatus("Saved " + savePath.string());
-          } else {
-            reportStatus(error);
-          }
+          exportScene();
         }
 #endif
       } else {
@@ -1990,14 +2459,10 @@ int main() {
     DrawAxes(0.3f);  // Much smaller axes so they don't dominate the view
 
     rlDisableBackfaceCulling();
-    for (int i = 0; i < model.meshCount; ++i) {
-      DrawMesh(model.meshes[i], outlineMat, model.transform);
-    }
+    DrawGpuScene(model, outlineMat.shader);
     rlEnableBackfaceCulling();
 
-    for (int i = 0; i < model.meshCount; ++i) {
-      DrawMesh(model.meshes[i], toonMat, model.transform);
-    }
+    DrawGpuScene(model, toonMat.shader);
     EndMode3D();
 
     const float margin = 20.0f;
@@ -2034,8 +2499,7 @@ int main() {
   UnloadMaterial(normalDepthMat);
   UnloadMaterial(outlineMat);   // also releases the shader
   UnloadShader(edgeShader);
-  DestroyModel(model);
-  JS_FreeRuntime(runtime);
+  DestroyGpuScene(model);
   CloseWindow();
 
   return 0;
@@ -0,0 +1,1153 @@
+#include "mesh_io.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef DINGCAD_USE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "parallel.h"
+
+namespace {
+
+constexpr size_t kStlRecordSize = 50;  // normal, 3 vertices, attribute count
+// Triangles per bulk write: 12.5 MiB of records.
+constexpr size_t kStlChunkTriangles = size_t{1} << 18;
+// Vertices or triangles per chunk of an indexed export, and chunks encoded
+// in parallel before they are written in order.
+constexpr size_t kIndexedChunkSize = size_t{1} << 14;
+constexpr size_t kChunksPerBatch = 64;
+
+struct Vec3f {
+  float x;
+  float y;
+  float z;
+};
+
+Vec3f FetchVertex(const manifold::MeshGL &mesh, uint32_t index) {
+  const size_t offset = static_cast<size_t>(index) * mesh.numProp;
+  return {
+      static_cast<float>(mesh.vertProperties[offset + 0]),
+      static_cast<float>(mesh.vertProperties[offset + 1]),
+      static_cast<float>(mesh.vertProperties[offset + 2])
+  };
+}
+
+Vec3f Subtract(const Vec3f &a, const Vec3f &b) {
+  return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+Vec3f Cross(const Vec3f &a, const Vec3f &b) {
+  return {a.y * b.z - a.z * b.y,
+          a.z * b.x - a.x * b.z,
+          a.x * b.y - a.y * b.x};
+}
+
+Vec3f Normalize(const Vec3f &v) {
+  const float lenSq = v.x * v.x + v.y * v.y + v.z * v.z;
+  if (lenSq <= 0.0f) return {0.0f, 0.0f, 0.0f};
+  const float invLen = 1.0f / std::sqrt(lenSq);
+  return {v.x * invLen, v.y * invLen, v.z * invLen};
+}
+
+
+// Vertices and triangles of a MeshGL as an indexed mesh. Property vertices
+// that MeshGL split along seams are folded back into the vertex they were
+// split from, so shared positions stay shared.
+class IndexedMesh {
+ public:
+  explicit IndexedMesh(const manifold::MeshGL &mesh) : mesh_(mesh) {
+    if (mesh.mergeFromVert.empty()) return;
+    mergeTo_.resize(mesh.NumVert());
+    for (size_t v = 0; v < mergeTo_.size(); ++v) mergeTo_[v] = static_cast<uint32_t>(v);
+    for (size_t i = 0; i < mesh.mergeFromVert.size(); ++i) {
+      mergeTo_[mesh.mergeFromVert[i]] = mesh.mergeToVert[i];
+    }
+  }
+
+  size_t NumVert() const { return mesh_.NumVert(); }
+  size_t NumTri() const { return mesh_.NumTri(); }
+  Vec3f Vertex(size_t v) const { return FetchVertex(mesh_, static_cast<uint32_t>(v)); }
+  uint32_t Index(size_t tri, int corner) const {
+    const uint32_t v = mesh_.triVerts[tri * 3 + corner];
+    return mergeTo_.empty() ? v : mergeTo_[v];
+  }
+
+ private:
+  const manifold::MeshGL &mesh_;
+  std::vector<uint32_t> mergeTo_;
+};
+
+// Number of kIndexedChunkSize chunks covering the vertices, then the
+// triangles. Chunk `c` covers vertices when c < VertexChunks().
+struct ChunkPlan {
+  size_t vertexChunks;
+  size_t triangleChunks;
+
+  explicit ChunkPlan(const IndexedMesh &mesh)
+      : vertexChunks((mesh.NumVert() + kIndexedChunkSize - 1) / kIndexedChunkSize),
+        triangleChunks((mesh.NumTri() + kIndexedChunkSize - 1) / kIndexedChunkSize) {}
+
+  size_t Count() const { return vertexChunks + triangleChunks; }
+};
+
+// Encodes chunks [0, count) with encode(chunk) in parallel, a batch at a
+// time, and hands them to write(chunk, encoded) in order, so memory stays
+// bounded by one batch. Stops early if write returns false.
+template <typename Piece, typename Encode, typename Write>
+bool EncodeChunks(size_t count, Encode &&encode, Write &&write,
+                  const ExportProgress &progress) {
+  std::vector<Piece> batch(std::min(count, kChunksPerBatch));
+  for (size_t first = 0; first < count; first += kChunksPerBatch) {
+    const size_t n = std::min(kChunksPerBatch, count - first);
+    ParallelFor(n, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) batch[i] = encode(first + i);
+    }, 1);
+    for (size_t i = 0; i < n; ++i) {
+      if (!write(first + i, batch[i])) return false;
+    }
+    if (progress) progress(static_cast<float>(first + n) / count);
+  }
+  return true;
+}
+
+void AppendFormat(std::string &out, const char *format, ...) {
+  char buffer[128];
+  va_list args;
+  va_start(args, format);
+  const int length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (length > 0) out.append(buffer, std::min<size_t>(length, sizeof(buffer) - 1));
+}
+
+// Appends a chunk of vertices or triangles as text, one per line.
+// `vertexFormat` takes three floats, `triangleFormat` three indices.
+std::string FormatTextChunk(const IndexedMesh &mesh, const ChunkPlan &plan, size_t chunk,
+                            const char *vertexFormat, const char *triangleFormat,
+                            uint32_t indexBase) {
+  std::string text;
+  if (chunk < plan.vertexChunks) {
+    const size_t begin = chunk * kIndexedChunkSize;
+    const size_t end = std::min(begin + kIndexedChunkSize, mesh.NumVert());
+    text.reserve((end - begin) * 48);
+    for (size_t v = begin; v < end; ++v) {
+      const Vec3f p = mesh.Vertex(v);
+      AppendFormat(text, vertexFormat, p.x, p.y, p.z);
+    }
+  } else {
+    const size_t begin = (chunk - plan.vertexChunks) * kIndexedChunkSize;
+    const size_t end = std::min(begin + kIndexedChunkSize, mesh.NumTri());
+    text.reserve((end - begin) * 40);
+    for (size_t tri = begin; tri < end; ++tri) {
+      AppendFormat(text, triangleFormat, mesh.Index(tri, 0) + indexBase,
+                   mesh.Index(tri, 1) + indexBase, mesh.Index(tri, 2) + indexBase);
+    }
+  }
+  return text;
+}
+
+void PutLE(std::string &out, uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+#ifndef DINGCAD_USE_ZLIB
+uint32_t Crc32Update(uint32_t crc, const std::string &data) {
+  static const auto kTable = []() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+      table[i] = c;
+    }
+    return table;
+  }();
+  crc = ~crc;
+  for (unsigned char byte : data) crc = kTable[(crc ^ byte) & 0xff] ^ (crc >> 8);
+  return ~crc;
+}
+#endif
+
+// One piece of a ZIP entry's data. With zlib, pieces are raw deflate streams
+// ended by a sync flush (the last by a final block), so independently
+// compressed pieces concatenate into one valid stream, as pigz does.
+struct ZipPiece {
+  std::string data;
+  uint32_t crc = 0;
+  size_t size = 0;  // uncompressed bytes
+  bool ok = true;   // false if compression failed
+};
+
+ZipPiece MakeZipPiece(const std::string &text, bool last) {
+  ZipPiece piece;
+  piece.size = text.size();
+#ifdef DINGCAD_USE_ZLIB
+  piece.crc = static_cast<uint32_t>(
+      crc32(0, reinterpret_cast<const Bytef *>(text.data()), static_cast<uInt>(text.size())));
+  z_stream stream{};
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) !=
+      Z_OK) {
+    piece.ok = false;
+    return piece;
+  }
+  // deflateBound only covers Z_FINISH; a sync flush adds a few marker bytes,
+  // so keep calling deflate, growing the buffer, until the flush completes.
+  piece.data.resize(deflateBound(&stream, static_cast<uLong>(text.size())) + 16);
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(text.data()));
+  stream.avail_in = static_cast<uInt>(text.size());
+  int status = Z_OK;
+  bool more = true;
+  while (more) {
+    if (stream.total_out == piece.data.size()) piece.data.resize(piece.data.size() * 2);
+    stream.next_out = reinterpret_cast<Bytef *>(&piece.data[stream.total_out]);
+    stream.avail_out = static_cast<uInt>(piece.data.size() - stream.total_out);
+    status = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+    more = status == Z_OK && (last || stream.avail_in != 0 || stream.avail_out == 0);
+  }
+  piece.ok = last ? status == Z_STREAM_END : status == Z_OK;
+  piece.data.resize(stream.total_out);
+  deflateEnd(&stream);
+#else
+  (void)last;
+  piece.data = text;
+#endif
+  return piece;
+}
+
+// Minimal ZIP writer: entries are added piece by piece and their local
+// headers patched once the sizes are known. Timestamps are fixed so equal
+// meshes give byte-identical files. No ZIP64, so entries stay under 4 GiB.
+class ZipWriter {
+ public:
+  explicit ZipWriter(std::ofstream &out) : out_(out) {}
+
+  void BeginEntry(const std::string &name) {
+    entry_ = Entry{name, static_cast<uint64_t>(out_.tellp())};
+    out_.write(LocalHeader(entry_).data(), 30 + name.size());
+  }
+
+  bool AddPiece(const ZipPiece &piece) {
+    if (!piece.ok) return false;
+#ifdef DINGCAD_USE_ZLIB
+    entry_.crc = static_cast<uint32_t>(crc32_combine(entry_.crc, piece.crc, piece.size));
+#else
+    entry_.crc = Crc32Update(entry_.crc, piece.data);
+#endif
+    entry_.compressedSize += piece.data.size();
+    entry_.size += piece.size;
+    out_.write(piece.data.data(), static_cast<std::streamsize>(piece.data.size()));
+    return static_cast<bool>(out_);
+  }
+
+  bool EndEntry() {
+    if (entry_.size > std::numeric_limits<uint32_t>::max() ||
+        entry_.compressedSize > std::numeric_limits<uint32_t>::max()) {
+      return false;
+    }
+    const auto end = out_.tellp();
+    out_.seekp(static_cast<std::streamoff>(entry_.offset));
+    out_.write(LocalHeader(entry_).data(), 30);
+    out_.seekp(end);
+    entries_.push_back(entry_);
+    return static_cast<bool>(out_);
+  }
+
+  bool AddEntry(const std::string &name, const std::string &text) {
+    BeginEntry(name);
+    return AddPiece(MakeZipPiece(text, true)) && EndEntry();
+  }
+
+  bool Finish() {
+    const uint64_t directoryOffset = static_cast<uint64_t>(out_.tellp());
+    std::string directory;
+    for (const auto &entry : entries_) {
+      PutLE(directory, 0x02014b50, 4);
+      PutLE(directory, 20, 2);  // made by
+      AppendCommon(directory, entry);
+      PutLE(directory, 0, 2);  // comment length
+      PutLE(directory, 0, 2);  // disk number
+      PutLE(directory, 0, 2);  // internal attributes
+      PutLE(directory, 0, 4);  // external attributes
+      PutLE(directory, entry.offset, 4);
+      directory += entry.name;
+    }
+    const size_t directorySize = directory.size();
+    PutLE(directory, 0x06054b50, 4);
+    PutLE(directory, 0, 2);
+    PutLE(directory, 0, 2);
+    PutLE(directory, entries_.size(), 2);
+    PutLE(directory, entries_.size(), 2);
+    PutLE(directory, directorySize, 4);
+    PutLE(directory, directoryOffset, 4);
+    PutLE(directory, 0, 2);
+    out_.write(directory.data(), static_cast<std::streamsize>(directory.size()));
+    return static_cast<bool>(out_) && directoryOffset <= std::numeric_limits<uint32_t>::max();
+  }
+
+ private:
+  struct Entry {
+    std::string name;
+    uint64_t offset = 0;
+    uint32_t crc = 0;
+    uint64_t compressedSize = 0;
+    uint64_t size = 0;
+  };
+
+#ifdef DINGCAD_USE_ZLIB
+  static constexpr int kMethod = 8;  // deflate
+#else
+  static constexpr int kMethod = 0;  // stored
+#endif
+
+  // Fields shared by local and central headers, from "version needed" to
+  // "extra field length".
+  static void AppendCommon(std::string &out, const Entry &entry) {
+    PutLE(out, 20, 2);       // version needed
+    PutLE(out, 0, 2);        // flags
+    PutLE(out, kMethod, 2);
+    PutLE(out, 0, 2);        // time
+    PutLE(out, 0x21, 2);     // date: 1980-01-01
+    PutLE(out, entry.crc, 4);
+    PutLE(out, entry.compressedSize, 4);
+    PutLE(out, entry.size, 4);
+    PutLE(out, entry.name.size(), 2);
+    PutLE(out, 0, 2);        // extra field length
+  }
+
+  static std::string LocalHeader(const Entry &entry) {
+    std::string header;
+    PutLE(header, 0x04034b50, 4);
+    AppendCommon(header, entry);
+    return header + entry.name;
+  }
+
+  std::ofstream &out_;
+  Entry entry_;
+  std::vector<Entry> entries_;
+};
+
+// Read-only view of a whole file: memory-mapped where the platform allows,
+// read into memory otherwise.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile() {
+#ifndef _WIN32
+    if (mapped_) ::munmap(mapped_, size_);
+#endif
+  }
+
+  bool Open(const std::filesystem::path &path, std::string &error) {
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      error = "cannot open " + path.string();
+      return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+      size_ = static_cast<size_t>(info.st_size);
+      void *mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped != MAP_FAILED) {
+        ::madvise(mapped, size_, MADV_WILLNEED);
+        mapped_ = mapped;
+        data_ = static_cast<const char *>(mapped);
+      }
+    }
+    ::close(fd);
+    if (mapped_) return true;
+#endif
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+      error = "cannot open " + path.string();
+      return false;
+    }
+    size_ = static_cast<size_t>(in.tellg());
+    buffer_.resize(size_);
+    in.seekg(0);
+    in.read(buffer_.data(), static_cast<std::streamsize>(size_));
+    if (!in) {
+      error = "read error in " + path.string();
+      return false;
+    }
+    data_ = buffer_.data();
+    return true;
+  }
+
+  const char *Data() const { return data_; }
+  size_t Size() const { return size_; }
+
+ private:
+  void *mapped_ = nullptr;
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+  std::vector<char> buffer_;
+};
+
+// Hash of a position's exact bits, with -0 folded into +0 so they weld.
+uint64_t HashPosition(const Vec3f &p) {
+  uint64_t h = 0x9E3779B97F4A7C15ull;
+  for (float v : {p.x, p.y, p.z}) {
+    if (v == 0.0f) v = 0.0f;
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    h = (h ^ bits) * 0x100000001B3ull;
+    h ^= h >> 29;
+  }
+  h *= 0xFF51AFD7ED558CCDull;
+  return h ^ (h >> 32);
+}
+
+bool SamePosition(const Vec3f &a, const Vec3f &b) {
+  return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+// Welds `count` positions read through fetch(i) by exact equality. Vertices
+// are spread over buckets by hash and each bucket is welded with its own
+// table in parallel. Returns the welded index of every input position and
+// fills `positions` (x/y/z) in order of first occurrence, so the result does
+// not depend on thread scheduling.
+template <typename Fetch>
+std::vector<uint32_t> WeldPositions(size_t count, Fetch &&fetch, std::vector<float> &positions) {
+  constexpr int kBucketBits = 8;
+  constexpr size_t kBuckets = size_t{1} << kBucketBits;
+  constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+
+  std::vector<uint64_t> hashes(count);
+  ParallelFor(count, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) hashes[i] = HashPosition(fetch(i));
+  });
+  auto bucketOf = [&](size_t i) { return static_cast<size_t>(hashes[i] >> (64 - kBucketBits)); };
+
+  // Counting sort into buckets; stable, so each bucket lists vertices in
+  // index order and the first one seen at a position is its lowest index.
+  std::vector<size_t> bucketStart(kBuckets + 1, 0);
+  for (size_t i = 0; i < count; ++i) ++bucketStart[bucketOf(i) + 1];
+  for (size_t b = 0; b < kBuckets; ++b) bucketStart[b + 1] += bucketStart[b];
+  std::vector<uint32_t> order(count);
+  std::vector<size_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+  for (size_t i = 0; i < count; ++i) order[fill[bucketOf(i)]++] = static_cast<uint32_t>(i);
+
+  std::vector<uint32_t> representative(count);
+  ParallelFor(kBuckets, [&](size_t firstBucket, size_t lastBucket) {
+    std::vector<uint32_t> table;
+    for (size_t b = firstBucket; b < lastBucket; ++b) {
+      const size_t n = bucketStart[b + 1] - bucketStart[b];
+      if (n == 0) continue;
+      size_t tableSize = 1;
+      while (tableSize < n * 2) tableSize <<= 1;
+      table.assign(tableSize, kEmpty);
+      for (size_t k = bucketStart[b]; k < bucketStart[b + 1]; ++k) {
+        const uint32_t i = order[k];
+        const Vec3f p = fetch(i);
+        size_t slot = hashes[i] & (tableSize - 1);
+        while (table[slot] != kEmpty && !(hashes[table[slot]] == hashes[i] &&
+                                          SamePosition(fetch(table[slot]), p))) {
+          slot = (slot + 1) & (tableSize - 1);
+        }
+        if (table[slot] == kEmpty) table[slot] = i;
+        representative[i] = table[slot];
+      }
+    }
+  }, 1);
+
+  std::vector<uint32_t> remap(count);
+  uint32_t unique = 0;
+  for (size_t i = 0; i < count; ++i) {
+    remap[i] = representative[i] == i ? unique++ : remap[representative[i]];
+  }
+  positions.resize(static_cast<size_t>(unique) * 3);
+  ParallelFor(count, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      if (representative[i] != i) continue;
+      const Vec3f p = fetch(i);
+      std::memcpy(&positions[static_cast<size_t>(remap[i]) * 3], &p, sizeof(p));
+    }
+  });
+  return remap;
+}
+
+// Drops triangles with a repeated corner, which welding leaves behind for
+// slivers thinner than float precision.
+void DropDegenerateTriangles(std::vector<uint32_t> &triVerts) {
+  size_t kept = 0;
+  for (size_t t = 0; t + 2 < triVerts.size(); t += 3) {
+    const uint32_t a = triVerts[t], b = triVerts[t + 1], c = triVerts[t + 2];
+    if (a == b || b == c || a == c) continue;
+    triVerts[kept++] = a;
+    triVerts[kept++] = b;
+    triVerts[kept++] = c;
+  }
+  triVerts.resize(kept);
+}
+
+constexpr size_t kStlHeaderSize = 84;  // 80-byte comment, triangle count
+
+bool IsBinaryStl(const MappedFile &file) {
+  if (file.Size() < kStlHeaderSize) return false;
+  uint32_t triCount;
+  std::memcpy(&triCount, file.Data() + 80, sizeof(triCount));
+  return file.Size() == kStlHeaderSize + static_cast<uint64_t>(triCount) * kStlRecordSize;
+}
+
+void ReadBinaryStl(const MappedFile &file, manifold::MeshGL &mesh) {
+  const char *records = file.Data() + kStlHeaderSize;
+  const size_t triCount = (file.Size() - kStlHeaderSize) / kStlRecordSize;
+  // Corner c of triangle t is input vertex 3t + c; skip each record's normal.
+  auto corner = [records](size_t i) {
+    Vec3f p;
+    std::memcpy(&p, records + (i / 3) * kStlRecordSize + (1 + i % 3) * sizeof(Vec3f), sizeof(p));
+    return p;
+  };
+  mesh.numProp = 3;
+  mesh.triVerts = WeldPositions(triCount * 3, corner, mesh.vertProperties);
+}
+
+enum class PlyType : uint8_t { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+
+bool ParsePlyType(const std::string &name, PlyType &type) {
+  static const std::pair<const char *, PlyType> kNames[] = {
+      {"char", PlyType::Int8},     {"int8", PlyType::Int8},       {"uchar", PlyType::UInt8},
+      {"uint8", PlyType::UInt8},   {"short", PlyType::Int16},     {"int16", PlyType::Int16},
+      {"ushort", PlyType::UInt16}, {"uint16", PlyType::UInt16},   {"int", PlyType::Int32},
+      {"int32", PlyType::Int32},   {"uint", PlyType::UInt32},     {"uint32", PlyType::UInt32},
+      {"float", PlyType::Float32}, {"float32", PlyType::Float32}, {"double", PlyType::Float64},
+      {"float64", PlyType::Float64}};
+  for (const auto &entry : kNames) {
+    if (name == entry.first) {
+      type = entry.second;
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t PlyTypeSize(PlyType type) {
+  switch (type) {
+    case PlyType::Int8:
+    case PlyType::UInt8: return 1;
+    case PlyType::Int16:
+    case PlyType::UInt16: return 2;
+    case PlyType::Int32:
+    case PlyType::UInt32:
+    case PlyType::Float32: return 4;
+    case PlyType::Float64: return 8;
+  }
+  return 0;
+}
+
+double ReadPlyValue(const char *src, PlyType type) {
+  auto load = [src](auto value) {
+    std::memcpy(&value, src, sizeof(value));
+    return static_cast<double>(value);
+  };
+  switch (type) {
+    case PlyType::Int8: return load(int8_t{});
+    case PlyType::UInt8: return load(uint8_t{});
+    case PlyType::Int16: return load(int16_t{});
+    case PlyType::UInt16: return load(uint16_t{});
+    case PlyType::Int32: return load(int32_t{});
+    case PlyType::UInt32: return load(uint32_t{});
+    case PlyType::Float32: return load(float{});
+    case PlyType::Float64: return load(double{});
+  }
+  return 0.0;
+}
+
+struct PlyProperty {
+  std::string name;
+  PlyType type;           // item type for lists
+  bool isList = false;
+  PlyType countType = PlyType::UInt8;
+};
+
+struct PlyElement {
+  std::string name;
+  size_t count = 0;
+  std::vector<PlyProperty> properties;
+};
+
+// Parses a binary little-endian PLY header. Returns Unsupported for ASCII
+// and big-endian files, and sets `dataOffset` to the first byte after it.
+MeshReadStatus ParsePlyHeader(const MappedFile &file, std::vector<PlyElement> &elements,
+                              size_t &dataOffset, std::string &error) {
+  const std::string_view text(file.Data(), std::min<size_t>(file.Size(), 1 << 16));
+  const size_t end = text.find("end_header");
+  const size_t eol = end == std::string_view::npos ? end : text.find('\n', end);
+  if (text.substr(0, 3) != "ply" || eol == std::string_view::npos) {
+    return MeshReadStatus::Unsupported;
+  }
+  dataOffset = eol + 1;
+
+  std::istringstream header{std::string(text.substr(0, end))};
+  std::string line;
+  bool binaryLittleEndian = false;
+  while (std::getline(header, line)) {
+    std::istringstream words(line);
+    std::string keyword;
+    words >> keyword;
+    if (keyword == "format") {
+      std::string format;
+      words >> format;
+      binaryLittleEndian = format == "binary_little_endian";
+    } else if (keyword == "element") {
+      PlyElement element;
+      words >> element.name >> element.count;
+      elements.push_back(std::move(element));
+    } else if (keyword == "property") {
+      if (elements.empty()) {
+        error = "PLY property before any element";
+        return MeshReadStatus::Error;
+      }
+      PlyProperty property;
+      std::string type;
+      words >> type;
+      if (type == "list") {
+        std::string countType;
+        words >> countType >> type;
+        property.isList = true;
+        if (!ParsePlyType(countType, property.countType)) type.clear();
+      }
+      if (!ParsePlyType(type, property.type)) {
+        error = "unknown PLY property type in '" + line + "'";
+        return MeshReadStatus::Error;
+      }
+      words >> property.name;
+      elements.back().properties.push_back(std::move(property));
+    }
+  }
+  return binaryLittleEndian ? MeshReadStatus::Ok : MeshReadStatus::Unsupported;
+}
+
+MeshReadStatus ReadBinaryPly(const MappedFile &file, manifold::MeshGL &mesh, std::string &error) {
+  std::vector<PlyElement> elements;
+  size_t offset = 0;
+  const MeshReadStatus header = ParsePlyHeader(file, elements, offset, error);
+  if (header != MeshReadStatus::Ok) return header;
+
+  const char *data = file.Data();
+  const size_t size = file.Size();
+  auto truncated = [&]() {
+    error = "PLY data is truncated";
+    return MeshReadStatus::Error;
+  };
+
+  // Vertices are fixed-size records read in place; faces are variable-length
+  // lists, decoded in one pass and fan-triangulated.
+  const char *vertexData = nullptr;
+  size_t vertexCount = 0;
+  size_t vertexStride = 0;
+  std::array<size_t, 3> axisOffset{};
+  std::array<PlyType, 3> axisType{};
+  std::vector<uint32_t> corners;
+  for (const PlyElement &element : elements) {
+    const bool isVertex = element.name == "vertex";
+    const bool isFace = element.name == "face";
+    bool fixedSize = true;
+    size_t stride = 0;
+    int found = 0;
+    for (const PlyProperty &property : element.properties) {
+      if (property.isList) {
+        fixedSize = false;
+        continue;
+      }
+      for (int axis = 0; axis < 3 && isVertex; ++axis) {
+        if (property.name != std::string(1, static_cast<char>('x' + axis))) continue;
+        if (property.type != PlyType::Float32 && property.type != PlyType::Float64) {
+          return MeshReadStatus::Unsupported;
+        }
+        axisOffset[axis] = stride;
+        axisType[axis] = property.type;
+        ++found;
+      }
+      stride += PlyTypeSize(property.type);
+    }
+
+    if (isVertex) {
+      if (found != 3 || !fixedSize) return MeshReadStatus::Unsupported;
+      if (stride * element.count > size - offset) return truncated();
+      vertexData = data + offset;
+      vertexCount = element.count;
+      vertexStride = stride;
+      offset += stride * element.count;
+      continue;
+    }
+    if (fixedSize) {
+      if (stride * element.count > size - offset) return truncated();
+      offset += stride * element.count;
+      continue;
+    }
+
+    // The face's index list is vertex_indices (or vertex_index); any other
+    // list or scalar is skipped.
+    for (size_t item = 0; item < element.count; ++item) {
+      for (const PlyProperty &property : element.properties) {
+        const size_t itemSize = PlyTypeSize(property.type);
+        size_t n = 1;
+        if (property.isList) {
+          const size_t countSize = PlyTypeSize(property.countType);
+          if (countSize > size - offset) return truncated();
+          n = static_cast<size_t>(ReadPlyValue(data + offset, property.countType));
+          offset += countSize;
+        }
+        if (n * itemSize > size - offset) return truncated();
+        if (isFace && property.isList &&
+            (property.name == "vertex_indices" || property.name == "vertex_index")) {
+          uint32_t first = 0;
+          uint32_t previous = 0;
+          for (size_t k = 0; k < n; ++k) {
+            const double value = ReadPlyValue(data + offset + k * itemSize, property.type);
+            if (value < 0 || value >= static_cast<double>(vertexCount)) {
+              error = "PLY face refers to a missing vertex";
+              return MeshReadStatus::Error;
+            }
+            const uint32_t index = static_cast<uint32_t>(value);
+            if (k == 0) first = index;
+            if (k >= 2) corners.insert(corners.end(), {first, previous, index});
+            previous = index;
+          }
+        }
+        offset += n * itemSize;
+      }
+    }
+  }
+  if (!vertexData) return MeshReadStatus::Unsupported;
+
+  auto vertex = [&](size_t i) {
+    const char *record = vertexData + i * vertexStride;
+    return Vec3f{static_cast<float>(ReadPlyValue(record + axisOffset[0], axisType[0])),
+                 static_cast<float>(ReadPlyValue(record + axisOffset[1], axisType[1])),
+                 static_cast<float>(ReadPlyValue(record + axisOffset[2], axisType[2]))};
+  };
+  const std::vector<uint32_t> remap = WeldPositions(vertexCount, vertex, mesh.vertProperties);
+  ParallelFor(corners.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) corners[i] = remap[corners[i]];
+  });
+  mesh.numProp = 3;
+  mesh.triVerts = std::move(corners);
+  return MeshReadStatus::Ok;
+}
+
+// Header of a mesh cache file; each array follows it in order, padded to
+// 8 bytes.
+struct MeshCacheHeader {
+  char magic[8];
+  uint64_t keyLength;  // key bytes follow the header, padded
+  uint64_t numProp;
+  uint64_t vertProperties;
+  uint64_t triVerts;
+  uint64_t mergeVerts;
+  uint64_t runIndex;
+  uint64_t runOriginalID;
+  uint64_t runTransform;
+  uint64_t faceID;
+  uint64_t halfedgeTangent;
+  double tolerance;
+};
+constexpr char kMeshCacheMagic[8] = "dcmsh03";
+
+size_t PaddedSize(size_t bytes) { return (bytes + 7) & ~size_t{7}; }
+
+template <typename T>
+bool WritePadded(std::ofstream &out, const std::vector<T> &values) {
+  const size_t bytes = values.size() * sizeof(T);
+  static const char kZeros[8] = {};
+  out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(bytes));
+  out.write(kZeros, static_cast<std::streamsize>(PaddedSize(bytes) - bytes));
+  return static_cast<bool>(out);
+}
+
+template <typename T>
+bool ReadPadded(const MappedFile &file, size_t &offset, size_t count, std::vector<T> &values) {
+  const size_t bytes = count * sizeof(T);
+  if (count > file.Size() / sizeof(T) || PaddedSize(bytes) > file.Size() - offset) return false;
+  values.resize(count);
+  std::memcpy(values.data(), file.Data() + offset, bytes);
+  offset += PaddedSize(bytes);
+  return true;
+}
+
+}  // namespace
+
+bool WriteMeshAsBinaryStl(const manifold::MeshGL &mesh,
+                          const std::filesystem::path &path,
+                          std::string &error,
+                          const ExportProgress &progress) {
+  const uint32_t triCount = static_cast<uint32_t>(mesh.NumTri());
+  if (triCount == 0) {
+    error = "Export failed: mesh is empty";
+    return false;
+  }
+
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    error = "Export failed: cannot open " + path.string();
+    return false;
+  }
+
+  std::array<char, 80> header{};
+  constexpr const char kHeader[] = "dingcad export";
+  std::memcpy(header.data(), kHeader, std::min(header.size(), std::strlen(kHeader)));
+  out.write(header.data(), header.size());
+  out.write(reinterpret_cast<const char *>(&triCount), sizeof(uint32_t));
+
+  std::vector<char> buffer(std::min<size_t>(triCount, kStlChunkTriangles) * kStlRecordSize);
+  for (size_t first = 0; first < triCount && out; first += kStlChunkTriangles) {
+    const size_t count = std::min<size_t>(kStlChunkTriangles, triCount - first);
+    ParallelFor(count, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        const size_t tri = first + i;
+        const Vec3f v0 = FetchVertex(mesh, mesh.triVerts[tri * 3 + 0]);
+        const Vec3f v1 = FetchVertex(mesh, mesh.triVerts[tri * 3 + 1]);
+        const Vec3f v2 = FetchVertex(mesh, mesh.triVerts[tri * 3 + 2]);
+        const Vec3f record[4] = {Normalize(Cross(Subtract(v1, v0), Subtract(v2, v0))), v0,
+                                 v1, v2};
+        char *dst = buffer.data() + i * kStlRecordSize;
+        std::memcpy(dst, record, sizeof(record));
+        std::memset(dst + sizeof(record), 0, kStlRecordSize - sizeof(record));
+      }
+    });
+    out.write(buffer.data(), static_cast<std::streamsize>(count * kStlRecordSize));
+    if (progress) progress(static_cast<float>(first + count) / triCount);
+  }
+
+  if (!out) {
+    error = "Export failed: write error";
+    return false;
+  }
+
+  return true;
+}
+
+bool WriteMeshAs3mf(const manifold::MeshGL &mesh,
+                    const std::filesystem::path &path,
+                    std::string &error,
+                    const ExportProgress &progress) {
+  if (mesh.NumTri() == 0) {
+    error = "Export failed: mesh is empty";
+    return false;
+  }
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    error = "Export failed: cannot open " + path.string();
+    return false;
+  }
+
+  ZipWriter zip(out);
+  bool ok = zip.AddEntry(
+      "[Content_Types].xml",
+      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+      "<Default Extension=\"rels\" "
+      "ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+      "<Default Extension=\"model\" "
+      "ContentType=\"application/vnd.ms-package.3dmanufacturing-3dmodel+xml\"/>"
+      "</Types>\n");
+  ok = ok && zip.AddEntry(
+                 "_rels/.rels",
+                 "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                 "<Relationships "
+                 "xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+                 "<Relationship Target=\"/3D/3dmodel.model\" Id=\"rel0\" "
+                 "Type=\"http://schemas.microsoft.com/3dmanufacturing/2013/01/3dmodel\"/>"
+                 "</Relationships>\n");
+
+  const IndexedMesh indexed(mesh);
+  const ChunkPlan plan(indexed);
+  zip.BeginEntry("3D/3dmodel.model");
+  ok = ok && zip.AddPiece(MakeZipPiece(
+                 "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                 "<model unit=\"millimeter\" xml:lang=\"en-US\" "
+                 "xmlns=\"http://schemas.microsoft.com/3dmanufacturing/core/2015/02\">\n"
+                 "<resources>\n<object id=\"1\" type=\"model\">\n<mesh>\n<vertices>\n",
+                 false));
+  ok = ok && EncodeChunks<ZipPiece>(
+                 plan.Count(),
+                 [&](size_t chunk) {
+                   std::string text = FormatTextChunk(
+                       indexed, plan, chunk, "<vertex x=\"%.9g\" y=\"%.9g\" z=\"%.9g\"/>\n",
+                       "<triangle v1=\"%u\" v2=\"%u\" v3=\"%u\"/>\n", 0);
+                   if (chunk + 1 == plan.vertexChunks) text += "</vertices>\n<triangles>\n";
+                   return MakeZipPiece(text, false);
+                 },
+                 [&](size_t, const ZipPiece &piece) { return zip.AddPiece(piece); }, progress);
+  ok = ok && zip.AddPiece(MakeZipPiece(
+                 "</triangles>\n</mesh>\n</object>\n</resources>\n"
+                 "<build>\n<item objectid=\"1\"/>\n</build>\n</model>\n",
+                 true));
+  if (ok && !zip.EndEntry()) {
+    error = "Export failed: 3MF model exceeds 4 GiB";
+    return false;
+  }
+  if (!ok || !zip.Finish()) {
+    error = "Export failed: compression or write error";
+    return false;
+  }
+  return true;
+}
+
+bool WriteMeshAsPly(const manifold::MeshGL &mesh,
+                    const std::filesystem::path &path,
+                    std::string &error,
+                    const ExportProgress &progress) {
+  if (mesh.NumTri() == 0) {
+    error = "Export failed: mesh is empty";
+    return false;
+  }
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    error = "Export failed: cannot open " + path.string();
+    return false;
+  }
+
+  const IndexedMesh indexed(mesh);
+  const ChunkPlan plan(indexed);
+  const std::string header = "ply\nformat binary_little_endian 1.0\ncomment dingcad export\n"
+                             "element vertex " + std::to_string(indexed.NumVert()) + "\n"
+                             "property float x\nproperty float y\nproperty float z\n"
+                             "element face " + std::to_string(indexed.NumTri()) + "\n"
+                             "property list uchar uint vertex_indices\nend_header\n";
+  out.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+  constexpr size_t kFaceRecordSize = 1 + 3 * sizeof(uint32_t);
+  const bool ok = EncodeChunks<std::string>(
+      plan.Count(),
+      [&](size_t chunk) {
+        std::string bytes;
+        if (chunk < plan.vertexChunks) {
+          const size_t begin = chunk * kIndexedChunkSize;
+          const size_t end = std::min(begin + kIndexedChunkSize, indexed.NumVert());
+          bytes.resize((end - begin) * sizeof(Vec3f));
+          for (size_t v = begin; v < end; ++v) {
+            const Vec3f p = indexed.Vertex(v);
+            std::memcpy(&bytes[(v - begin) * sizeof(Vec3f)], &p, sizeof(Vec3f));
+          }
+        } else {
+          const size_t begin = (chunk - plan.vertexChunks) * kIndexedChunkSize;
+          const size_t end = std::min(begin + kIndexedChunkSize, indexed.NumTri());
+          bytes.resize((end - begin) * kFaceRecordSize);
+          for (size_t tri = begin; tri < end; ++tri) {
+            char *dst = &bytes[(tri - begin) * kFaceRecordSize];
+            const uint32_t corners[3] = {indexed.Index(tri, 0), indexed.Index(tri, 1),
+                                         indexed.Index(tri, 2)};
+            dst[0] = 3;
+            std::memcpy(dst + 1, corners, sizeof(corners));
+          }
+        }
+        return bytes;
+      },
+      [&](size_t, const std::string &bytes) {
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(out);
+      },
+      progress);
+
+  if (!ok || !out) {
+    error = "Export failed: write error";
+    return false;
+  }
+  return true;
+}
+
+bool WriteMeshAsObj(const manifold::MeshGL &mesh,
+                    const std::filesystem::path &path,
+                    std::string &error,
+                    const ExportProgress &progress) {
+  if (mesh.NumTri() == 0) {
+    error = "Export failed: mesh is empty";
+    return false;
+  }
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    error = "Export failed: cannot open " + path.string();
+    return false;
+  }
+
+  const IndexedMesh indexed(mesh);
+  const ChunkPlan plan(indexed);
+  out << "# dingcad export\n";
+  const bool ok = EncodeChunks<std::string>(
+      plan.Count(),
+      [&](size_t chunk) {
+        return FormatTextChunk(indexed, plan, chunk, "v %.9g %.9g %.9g\n", "f %u %u %u\n", 1);
+      },
+      [&](size_t, const std::string &text) {
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        return static_cast<bool>(out);
+      },
+      progress);
+
+  if (!ok || !out) {
+    error = "Export failed: write error";
+    return false;
+  }
+  return true;
+}
+
+bool WriteMeshFile(const manifold::MeshGL &mesh,
+                   const std::filesystem::path &path,
+                   std::string &error,
+                   const ExportProgress &progress) {
+  std::string extension = path.extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  if (extension == ".stl") return WriteMeshAsBinaryStl(mesh, path, error, progress);
+  if (extension == ".3mf") return WriteMeshAs3mf(mesh, path, error, progress);
+  if (extension == ".ply") return WriteMeshAsPly(mesh, path, error, progress);
+  if (extension == ".obj") return WriteMeshAsObj(mesh, path, error, progress);
+  error = "Export failed: unsupported format '" + extension + "' (use .stl, .3mf, .ply or .obj)";
+  return false;
+}
+
+MeshReadStatus ReadMeshFast(const std::filesystem::path &path,
+                            manifold::MeshGL &mesh,
+                            std::string &error) {
+  std::string extension = path.extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  if (extension != ".stl" && extension != ".ply") return MeshReadStatus::Unsupported;
+
+  MappedFile file;
+  if (!file.Open(path, error)) return MeshReadStatus::Error;
+  manifold::MeshGL result;
+  if (extension == ".stl") {
+    if (!IsBinaryStl(file)) return MeshReadStatus::Unsupported;
+    ReadBinaryStl(file, result);
+  } else {
+    const MeshReadStatus status = ReadBinaryPly(file, result, error);
+    if (status != MeshReadStatus::Ok) return status;
+  }
+  DropDegenerateTriangles(result.triVerts);
+  mesh = std::move(result);
+  return MeshReadStatus::Ok;
+}
+
+bool WriteMeshCache(const manifold::MeshGL &mesh, const std::string &key,
+                    const std::filesystem::path &path) {
+  std::error_code ec;
+  std::filesystem::create_directories(path.parent_path(), ec);
+  // Unique per thread: batch runs may write the same entry concurrently.
+  auto temp = path;
+  temp += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+  {
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    MeshCacheHeader header{};
+    std::memcpy(header.magic, kMeshCacheMagic, sizeof(kMeshCacheMagic));
+    header.keyLength = key.size();
+    header.numProp = mesh.numProp;
+    header.vertProperties = mesh.vertProperties.size();
+    header.triVerts = mesh.triVerts.size();
+    header.mergeVerts = mesh.mergeFromVert.size();
+    header.runIndex = mesh.runIndex.size();
+    header.runOriginalID = mesh.runOriginalID.size();
+    header.runTransform = mesh.runTransform.size();
+    header.faceID = mesh.faceID.size();
+    header.halfedgeTangent = mesh.halfedgeTangent.size();
+    header.tolerance = mesh.tolerance;
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    const bool ok = WritePadded(out, std::vector<char>(key.begin(), key.end())) &&
+                    WritePadded(out, mesh.vertProperties) && WritePadded(out, mesh.triVerts) &&
+                    WritePadded(out, mesh.mergeFromVert) && WritePadded(out, mesh.mergeToVert) &&
+                    WritePadded(out, mesh.runIndex) && WritePadded(out, mesh.runOriginalID) &&
+                    WritePadded(out, mesh.runTransform) && WritePadded(out, mesh.faceID) &&
+                    WritePadded(out, mesh.halfedgeTangent);
+    if (!ok) {
+      out.close();
+      std::filesystem::remove(temp, ec);
+      return false;
+    }
+  }
+  // Rename so a concurrent reader never maps a half-written file.
+  std::filesystem::rename(temp, path, ec);
+  return !ec;
+}
+
+bool ReadMeshCache(const std::filesystem::path &path, const std::string &key,
+                   manifold::MeshGL &mesh) {
+  std::error_code ec;
+  if (!std::filesystem::is_regular_file(path, ec)) return false;
+  MappedFile file;
+  std::string error;
+  if (!file.Open(path, error) || file.Size() < sizeof(MeshCacheHeader)) return false;
+  MeshCacheHeader header;
+  std::memcpy(&header, file.Data(), sizeof(header));
+  if (std::memcmp(header.magic, kMeshCacheMagic, sizeof(kMeshCacheMagic)) != 0 ||
+      header.keyLength != key.size() || header.numProp < 3) {
+    return false;
+  }
+  size_t offset = sizeof(header);
+  std::vector<char> storedKey;
+  if (!ReadPadded(file, offset, header.keyLength, storedKey) ||
+      !std::equal(storedKey.begin(), storedKey.end(), key.begin())) {
+    return false;
+  }
+  manifold::MeshGL result;
+  result.numProp = static_cast<uint32_t>(header.numProp);
+  result.tolerance = static_cast<float>(header.tolerance);
+  if (!ReadPadded(file, offset, header.vertProperties, result.vertProperties) ||
+      !ReadPadded(file, offset, header.triVerts, result.triVerts) ||
+      !ReadPadded(file, offset, header.mergeVerts, result.mergeFromVert) ||
+      !ReadPadded(file, offset, header.mergeVerts, result.mergeToVert) ||
+      !ReadPadded(file, offset, header.runIndex, result.runIndex) ||
+      !ReadPadded(file, offset, header.runOriginalID, result.runOriginalID) ||
+      !ReadPadded(file, offset, header.runTransform, result.runTransform) ||
+      !ReadPadded(file, offset, header.faceID, result.faceID) ||
+      !ReadPadded(file, offset, header.halfedgeTangent, result.halfedgeTangent)) {
+    return false;
+  }
+  mesh = std::move(result);
+  std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+  return true;
+}
+
+void PruneMeshCache(const std::filesystem::path &dir, uintmax_t maxBytes) {
+  struct CacheFile {
+    std::filesystem::path path;
+    std::filesystem::file_time_type used;
+    uintmax_t size;
+  };
+  std::vector<CacheFile> files;
+  uintmax_t total = 0;
+  std::error_code ec;
+  for (std::filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+    if (it->path().extension() != ".mesh") continue;
+    std::error_code statErr;
+    const uintmax_t size = it->file_size(statErr);
+    const auto used = it->last_write_time(statErr);
+    if (statErr) continue;
+    files.push_back({it->path(), used, size});
+    total += size;
+  }
+  if (total <= maxBytes) return;
+  std::sort(files.begin(), files.end(),
+            [](const CacheFile &a, const CacheFile &b) { return a.used < b.used; });
+  for (const auto &file : files) {
+    if (total <= maxBytes) break;
+    if (std::filesystem::remove(file.path, ec)) total -= file.size;
+  }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+#include "manifold/manifold.h"
+
+// Receives the fraction of an export written so far, from the exporting
+// thread.
+using ExportProgress = std::function<void(float)>;
+
+// Writes `mesh` as binary STL with per-facet normals. Records are built in
+// parallel, a large chunk at a time, and written in bulk. Returns false and
+// sets `error` on failure.
+bool WriteMeshAsBinaryStl(const manifold::MeshGL &mesh,
+                          const std::filesystem::path &path,
+                          std::string &error,
+                          const ExportProgress &progress = {});
+
+// Indexed formats: each vertex is written once and triangles refer to it, so
+// files are about a third the size of STL and slicers need not re-weld.
+// Chunks of the vertex and triangle lists are encoded in parallel.
+
+// 3MF package (ZIP with the model as XML), in millimetres. The model is
+// deflated when the build has zlib and stored otherwise.
+bool WriteMeshAs3mf(const manifold::MeshGL &mesh,
+                    const std::filesystem::path &path,
+                    std::string &error,
+                    const ExportProgress &progress = {});
+
+// Binary little-endian PLY: float x/y/z vertices, uint triangle lists.
+bool WriteMeshAsPly(const manifold::MeshGL &mesh,
+                    const std::filesystem::path &path,
+                    std::string &error,
+                    const ExportProgress &progress = {});
+
+// Wavefront OBJ with positions and faces only.
+bool WriteMeshAsObj(const manifold::MeshGL &mesh,
+                    const std::filesystem::path &path,
+                    std::string &error,
+                    const ExportProgress &progress = {});
+
+// Picks the writer from the extension of `path`: .stl, .3mf, .ply or .obj.
+bool WriteMeshFile(const manifold::MeshGL &mesh,
+                   const std::filesystem::path &path,
+                   std::string &error,
+                   const ExportProgress &progress = {});
+
+enum class MeshReadStatus {
+  Ok,
+  Unsupported,  // not a format the fast reader handles; use a general importer
+  Error,
+};
+
+// Fast native import of binary STL and binary little-endian PLY. The file is
+// memory-mapped, and vertices are welded by exact position in parallel so the
+// result is an indexed MeshGL (x/y/z only) ready for manifold::Manifold.
+// Triangles that weld down to a line or point are dropped. ASCII files and
+// other formats report Unsupported and leave `mesh` untouched.
+MeshReadStatus ReadMeshFast(const std::filesystem::path &path,
+                            manifold::MeshGL &mesh,
+                            std::string &error);
+
+// Compact binary copy of a MeshGL (properties, triangles, merge vectors, runs,
+// face IDs, smoothing tangents and tolerance) for on-disk caches. Arrays are 8-byte aligned so the
+// file is read back through a memory map. `key` is the full key material the
+// file name was hashed from (e.g. path, size, mtime and options); it is stored
+// in the file and ReadMeshCache fails unless it matches byte for byte, so a
+// stale file or one whose name collides is not returned. Writes go through a
+// temporary file and a rename. A successful read refreshes the file's mtime,
+// which PruneMeshCache treats as last use.
+bool WriteMeshCache(const manifold::MeshGL &mesh, const std::string &key,
+                    const std::filesystem::path &path);
+bool ReadMeshCache(const std::filesystem::path &path, const std::string &key,
+                   manifold::MeshGL &mesh);
+
+// Deletes the least recently used .mesh files in `dir` until the rest take
+// at most `maxBytes`.
+void PruneMeshCache(const std::filesystem::path &dir, uintmax_t maxBytes);
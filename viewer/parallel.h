@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#ifdef DINGCAD_USE_TBB
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+#endif
+
+// Runs body(begin, end) over [0, count) on TBB's pool when the build has it.
+// `grain` is the smallest range handed to one task; lower it for loops whose
+// iterations are large (e.g. one chunk of an export each).
+template <typename Body>
+void ParallelFor(size_t count, Body &&body, size_t grain = 4096) {
+#ifdef DINGCAD_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, count, grain),
+                    [&](const tbb::blocked_range<size_t> &range) {
+                      body(range.begin(), range.end());
+                    });
+#else
+  (void)grain;
+  body(size_t{0}, count);
+#endif
+}
+
+// Runs body(node) for every node of a DAG whose nodes are numbered in
+// topological order; dependents[i] lists the nodes fed by i, once per edge.
+// With TBB each node starts as soon as its own inputs are done, so a slow
+// node only holds back the nodes that consume it.
+template <typename Body>
+void ParallelGraph(const std::vector<std::vector<size_t>> &dependents, Body &&body) {
+#ifdef DINGCAD_USE_TBB
+  const size_t count = dependents.size();
+  std::unique_ptr<std::atomic<size_t>[]> remaining(new std::atomic<size_t>[count]);
+  for (size_t i = 0; i < count; ++i) remaining[i].store(0, std::memory_order_relaxed);
+  for (const auto &next : dependents) {
+    for (size_t node : next) remaining[node].fetch_add(1, std::memory_order_relaxed);
+  }
+  tbb::task_group group;
+  std::function<void(size_t)> run = [&](size_t node) {
+    body(node);
+    for (size_t next : dependents[node]) {
+      if (remaining[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        group.run([&run, next] { run(next); });
+      }
+    }
+  };
+  for (size_t i = 0; i < count; ++i) {
+    if (remaining[i].load(std::memory_order_relaxed) == 0) group.run([&run, i] { run(i); });
+  }
+  group.wait();
+#else
+  for (size_t node = 0; node < dependents.size(); ++node) body(node);
+#endif
+}
@@ -0,0 +1,625 @@
+#include "scene_loader.h"
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "js_bindings.h"
+
+namespace {
+uint64_t HashBytes(const std::string &data) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (unsigned char c : data) {
+    hash = (hash ^ c) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+#ifdef DINGCAD_BYTECODE_CACHE_DIR
+// On-disk copy of the bytecode cache so a fresh viewer starts warm. Each
+// module gets one file named after its path hash: a header, the module
+// path, then the bytecode.
+struct BytecodeFileHeader {
+  char magic[8];
+  int64_t mtime;
+  uint64_t size;
+  uint64_t contentHash;
+  uint64_t flags;
+  uint64_t pathLength;
+  uint64_t bytecodeLength;
+};
+constexpr char kBytecodeMagic[8] = "dcqbc02";
+constexpr uint64_t kBytecodeUseCache = 1;
+
+std::filesystem::path BytecodeCacheFile(const std::string &moduleName) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.qbc",
+                static_cast<unsigned long long>(HashBytes(moduleName)));
+  return std::filesystem::path(DINGCAD_BYTECODE_CACHE_DIR) / name;
+}
+
+std::optional<ModuleBytecode> ReadBytecodeFile(const std::string &moduleName) {
+  std::ifstream in(BytecodeCacheFile(moduleName), std::ios::binary);
+  if (!in) return std::nullopt;
+  BytecodeFileHeader header{};
+  if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kBytecodeMagic, sizeof(kBytecodeMagic)) != 0 ||
+      header.pathLength != moduleName.size()) {
+    return std::nullopt;
+  }
+  std::string path(header.pathLength, '\0');
+  if (!in.read(path.data(), path.size()) || path != moduleName) return std::nullopt;
+  ModuleBytecode entry;
+  entry.mtime = std::filesystem::file_time_type(
+      std::filesystem::file_time_type::duration(header.mtime));
+  entry.size = header.size;
+  entry.contentHash = header.contentHash;
+  entry.useCache = (header.flags & kBytecodeUseCache) != 0;
+  entry.bytecode.resize(header.bytecodeLength);
+  if (!in.read(reinterpret_cast<char *>(entry.bytecode.data()), entry.bytecode.size())) {
+    return std::nullopt;
+  }
+  return entry;
+}
+
+void WriteBytecodeFile(const std::string &moduleName, const ModuleBytecode &entry) {
+  const auto target = BytecodeCacheFile(moduleName);
+  std::error_code ec;
+  std::filesystem::create_directories(target.parent_path(), ec);
+  // Unique per thread: batch runs may write the same module concurrently.
+  auto temp = target;
+  temp += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+  {
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    if (!out) return;
+    BytecodeFileHeader header{};
+    std::memcpy(header.magic, kBytecodeMagic, sizeof(kBytecodeMagic));
+    header.mtime = static_cast<int64_t>(entry.mtime.time_since_epoch().count());
+    header.size = entry.size;
+    header.contentHash = entry.contentHash;
+    header.flags = entry.useCache ? kBytecodeUseCache : 0;
+    header.pathLength = moduleName.size();
+    header.bytecodeLength = entry.bytecode.size();
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(moduleName.data(), moduleName.size());
+    out.write(reinterpret_cast<const char *>(entry.bytecode.data()), entry.bytecode.size());
+    if (!out) return;
+  }
+  // Rename so a concurrent viewer never reads a half-written file.
+  std::filesystem::rename(temp, target, ec);
+}
+#endif
+
+// True if the module opts into reuse across reloads with a "use cache"
+// directive in its prologue (where "use strict" would go).
+bool HasUseCacheDirective(const std::string &source) {
+  size_t i = 0;
+  const size_t n = source.size();
+  for (;;) {
+    while (i < n) {
+      if (std::isspace(static_cast<unsigned char>(source[i]))) {
+        ++i;
+      } else if (source.compare(i, 2, "//") == 0) {
+        i = source.find('\n', i);
+        if (i == std::string::npos) return false;
+      } else if (source.compare(i, 2, "/*") == 0) {
+        i = source.find("*/", i + 2);
+        if (i == std::string::npos) return false;
+        i += 2;
+      } else {
+        break;
+      }
+    }
+    if (i >= n || (source[i] != '"' && source[i] != '\'')) return false;
+    const size_t end = source.find(source[i], i + 1);
+    if (end == std::string::npos) return false;
+    if (source.compare(i + 1, end - i - 1, "use cache") == 0) return true;
+    i = end + 1;
+    while (i < n && (source[i] == ' ' || source[i] == '\t')) ++i;
+    if (i < n && source[i] == ';') ++i;
+  }
+}
+
+// Returns JS_EXCEPTION with the exception already cleared when the bytecode
+// is unreadable (e.g. written by another QuickJS build), so the caller can
+// simply recompile.
+JSValue ReadModuleBytecode(JSContext *ctx, const ModuleBytecode &entry) {
+  JSValue module = JS_ReadObject(ctx, entry.bytecode.data(), entry.bytecode.size(),
+                                 JS_READ_OBJ_BYTECODE);
+  if (JS_IsException(module)) {
+    JS_FreeValue(ctx, JS_GetException(ctx));
+  }
+  return module;
+}
+
+// Compiles `path` as a module named by its plain path, reusing cached
+// bytecode when the file is unchanged: mtime and size are checked first, and
+// a touched-but-identical file is caught by its content hash. Bytecode embeds
+// the module name, which is why it is always the path (see ModuleReuse).
+// Returns JS_EXCEPTION with a pending exception on failure.
+JSValue CompileModuleCached(JSContext *ctx, ModuleLoaderData *data,
+                            const std::filesystem::path &path,
+                            ModuleReuse::Module &record) {
+  const std::string moduleName = path.string();
+  std::error_code ec;
+  const auto mtime = std::filesystem::last_write_time(path, ec);
+  const uintmax_t size = ec ? 0 : std::filesystem::file_size(path, ec);
+  const bool cacheable = data != nullptr && !ec;
+  // Stat before reading, so a save racing this load looks changed next time.
+  record.mtime = mtime;
+  record.size = size;
+  bool &useCache = record.useCache;
+
+  ModuleBytecode *cached = nullptr;
+  if (cacheable) {
+    auto it = data->bytecodeCache.find(moduleName);
+#ifdef DINGCAD_BYTECODE_CACHE_DIR
+    if (it == data->bytecodeCache.end()) {
+      if (auto onDisk = ReadBytecodeFile(moduleName)) {
+        it = data->bytecodeCache.emplace(moduleName, std::move(*onDisk)).first;
+      }
+    }
+#endif
+    if (it != data->bytecodeCache.end()) cached = &it->second;
+    if (cached && cached->mtime == mtime && cached->size == size) {
+      JSValue module = ReadModuleBytecode(ctx, *cached);
+      if (!JS_IsException(module)) {
+        useCache = cached->useCache;
+        return module;
+      }
+    }
+  }
+
+  auto source = ReadTextFile(path);
+  if (!source) {
+    return JS_ThrowReferenceError(ctx, "Unable to load module '%s'", moduleName.c_str());
+  }
+  const uint64_t contentHash = HashBytes(*source);
+  useCache = HasUseCacheDirective(*source);
+  if (cached && cached->contentHash == contentHash) {
+    JSValue module = ReadModuleBytecode(ctx, *cached);
+    if (!JS_IsException(module)) {
+      cached->mtime = mtime;
+      cached->size = size;
+#ifdef DINGCAD_BYTECODE_CACHE_DIR
+      WriteBytecodeFile(moduleName, *cached);
+#endif
+      return module;
+    }
+  }
+
+  JSValue funcVal = JS_Eval(ctx, source->c_str(), source->size(), moduleName.c_str(),
+                            JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY);
+  if (JS_IsException(funcVal) || !cacheable) return funcVal;
+
+  size_t length = 0;
+  uint8_t *bytecode = JS_WriteObject(ctx, &length, funcVal, JS_WRITE_OBJ_BYTECODE);
+  if (!bytecode) {
+    JS_FreeValue(ctx, JS_GetException(ctx));
+    return funcVal;
+  }
+  ModuleBytecode entry;
+  entry.mtime = mtime;
+  entry.size = size;
+  entry.contentHash = contentHash;
+  entry.useCache = useCache;
+  entry.bytecode.assign(bytecode, bytecode + length);
+  js_free(ctx, bytecode);
+#ifdef DINGCAD_BYTECODE_CACHE_DIR
+  WriteBytecodeFile(moduleName, entry);
+#endif
+  data->bytecodeCache[moduleName] = std::move(entry);
+  return funcVal;
+}
+
+// Strips the "#N" suffix that re-evaluated modules get in a reused context.
+std::string ModulePathFromName(const std::string &name) {
+  const size_t hash = name.rfind('#');
+  if (hash == std::string::npos || hash + 1 == name.size()) return name;
+  for (size_t i = hash + 1; i < name.size(); ++i) {
+    if (!std::isdigit(static_cast<unsigned char>(name[i]))) return name;
+  }
+  return name.substr(0, hash);
+}
+
+// Returns the context a scene load evaluates in: the previous one when it
+// still holds modules that can be reused, otherwise a fresh one.
+JSContext *BeginSceneContext(JSRuntime *runtime, ModuleLoaderData &data) {
+  constexpr size_t kMaxStaleModules = 64;
+  ModuleReuse &reuse = data.reuse;
+  reuse.names.clear();
+  reuse.loaded.clear();
+  reuse.edges.clear();
+  ++reuse.serial;
+
+  if (reuse.context) {
+    std::unordered_map<std::string, bool> memo;
+    std::function<bool(const std::string &)> reusable = [&](const std::string &path) {
+      auto known = memo.find(path);
+      if (known != memo.end()) return known->second;
+      memo[path] = false;  // modules in an import cycle never qualify
+      auto it = reuse.modules.find(path);
+      if (it == reuse.modules.end() || !it->second.useCache) return false;
+      std::error_code ec;
+      const auto mtime = std::filesystem::last_write_time(path, ec);
+      if (ec || mtime != it->second.mtime) return false;
+      const auto size = std::filesystem::file_size(path, ec);
+      if (ec || size != it->second.size) return false;
+      for (const auto &dep : it->second.imports) {
+        if (!reusable(dep)) return false;
+      }
+      memo[path] = true;
+      return true;
+    };
+    for (const auto &[path, module] : reuse.modules) {
+      if (reusable(path)) reuse.names[path] = module.name;
+    }
+    if (reuse.names.empty() || reuse.staleInstances > kMaxStaleModules) {
+      ReleaseSceneContext(data);
+      reuse.names.clear();
+    }
+  }
+
+  reuse.freshContext = reuse.context == nullptr;
+  if (!reuse.context) reuse.context = JS_NewContext(runtime);
+  return reuse.context;
+}
+
+// Ends a scene load. Reused modules never reach the loader, so their files are
+// added to the dependency set here. A successful load records what it
+// evaluated for the next one; after a failure (modules may be half evaluated)
+// or when nothing opted in, the context is dropped.
+void FinishSceneContext(ModuleLoaderData &data, const std::string &scenePath, bool success) {
+  ModuleReuse &reuse = data.reuse;
+  std::vector<std::string> pending{scenePath};
+  std::set<std::string> visited;
+  while (!pending.empty()) {
+    const std::string path = std::move(pending.back());
+    pending.pop_back();
+    if (!visited.insert(path).second) continue;
+    data.dependencies.insert(path);
+    auto edges = reuse.edges.find(path);
+    if (edges != reuse.edges.end()) {
+      pending.insert(pending.end(), edges->second.begin(), edges->second.end());
+    } else if (auto kept = reuse.modules.find(path); kept != reuse.modules.end()) {
+      pending.insert(pending.end(), kept->second.imports.begin(), kept->second.imports.end());
+    }
+  }
+
+  if (!success) {
+    ReleaseSceneContext(data);
+    return;
+  }
+
+  std::unordered_map<std::string, ModuleReuse::Module> current;
+  size_t keptCount = 0;
+  bool anyUseCache = false;
+  for (const auto &[path, name] : reuse.names) {
+    auto fresh = reuse.loaded.find(path);
+    if (fresh != reuse.loaded.end()) {
+      fresh->second.imports = std::move(reuse.edges[path]);
+      current[path] = std::move(fresh->second);
+    } else if (auto kept = reuse.modules.find(path);
+               kept != reuse.modules.end() && kept->second.name == name) {
+      current[path] = std::move(kept->second);
+      ++keptCount;
+    } else {
+      continue;
+    }
+    anyUseCache = anyUseCache || current[path].useCache;
+  }
+  if (!reuse.freshContext) {
+    // The previous scene module plus every instance that was re-evaluated.
+    reuse.staleInstances += 1 + reuse.modules.size() - keptCount;
+  }
+  reuse.modules = std::move(current);
+  if (!anyUseCache) ReleaseSceneContext(data);
+}
+
+}  // namespace
+
+std::optional<std::string> ReadTextFile(const std::filesystem::path &path) {
+#ifdef __EMSCRIPTEN__
+  // Use Emscripten's virtual filesystem for web
+  FILE* file = fopen(path.string().c_str(), "r");
+  if (!file) return std::nullopt;
+  std::string content;
+  char buffer[4096];
+  while (fgets(buffer, sizeof(buffer), file)) {
+    content += buffer;
+  }
+  fclose(file);
+  return content;
+#else
+  std::ifstream file(path);
+  if (!file) return std::nullopt;
+  std::ostringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+#endif
+}
+
+// Resolves imports against the importing module's directory and hands back
+// the name the module has in the current scene context (see ModuleReuse).
+char *NormalizeModuleName(JSContext *ctx, const char *baseName, const char *moduleName,
+                          void *opaque) {
+  auto *data = static_cast<ModuleLoaderData *>(opaque);
+  // Inline module names are left for the loader to reject.
+  if (moduleName[0] == '<' || strncmp(moduleName, "/dev/", 5) == 0) {
+    return js_strdup(ctx, moduleName);
+  }
+  const std::string basePath = ModulePathFromName(baseName);
+  std::filesystem::path resolved(moduleName);
+  if (resolved.is_relative()) {
+    resolved = std::filesystem::path(basePath).parent_path() / resolved;
+  }
+  const std::string path = std::filesystem::absolute(resolved).lexically_normal().string();
+  if (!data) return js_strdup(ctx, path.c_str());
+
+  ModuleReuse &reuse = data->reuse;
+  reuse.edges[basePath].insert(path);
+  auto it = reuse.names.find(path);
+  if (it == reuse.names.end()) {
+    std::string name = reuse.freshContext ? path : path + "#" + std::to_string(reuse.serial);
+    it = reuse.names.emplace(path, std::move(name)).first;
+  }
+  return js_strdup(ctx, it->second.c_str());
+}
+
+// Drops the scene context and everything evaluated in it.
+void ReleaseSceneContext(ModuleLoaderData &data) {
+  ModuleReuse &reuse = data.reuse;
+  if (reuse.context) JS_FreeContext(reuse.context);
+  reuse.context = nullptr;
+  reuse.modules.clear();
+  reuse.staleInstances = 0;
+}
+
+JSModuleDef *FilesystemModuleLoader(JSContext *ctx, const char *module_name, void *opaque) {
+  auto *data = static_cast<ModuleLoaderData *>(opaque);
+  
+  // Ignore special inline module names that shouldn't go through the filesystem loader
+  // These are used for inline code evaluation and shouldn't trigger filesystem resolution
+  if (strncmp(module_name, "<", 1) == 0 || strncmp(module_name, "/dev/", 5) == 0) {
+    // This is an inline module (like <inline-scene>, <cmdline>, or /dev/stdin)
+    // QuickJS uses these for inline code and shouldn't try to load them via filesystem
+#ifdef __EMSCRIPTEN__
+    EM_ASM({
+      console.warn('⚠️ ModuleLoader called for inline module:', UTF8ToString($0), '- this should not happen during compilation');
+    }, module_name);
+#endif
+    JS_ThrowReferenceError(ctx, "Module '%s' is an inline module and cannot be loaded via filesystem", module_name);
+    return nullptr;
+  }
+  
+  std::filesystem::path resolved(ModulePathFromName(module_name));
+  if (resolved.is_relative()) {
+    const std::filesystem::path base = data && !data->baseDir.empty()
+                                           ? data->baseDir
+                                           : std::filesystem::current_path();
+    resolved = base / resolved;
+  }
+  resolved = std::filesystem::absolute(resolved).lexically_normal();
+  // The name the normaliser handed out, which later imports resolve to.
+  const std::string moduleName =
+      ModulePathFromName(module_name) != module_name ? std::string(module_name) : resolved.string();
+
+  // Instances are registered under their plain path, so QuickJS does not find
+  // them by a "path#N" name and asks again: hand back the one this load
+  // evaluated, or the kept instance the name was bound to.
+  if (data) {
+    ModuleReuse &reuse = data->reuse;
+    auto fresh = reuse.loaded.find(resolved.string());
+    if (fresh != reuse.loaded.end() && fresh->second.name == moduleName) {
+      return fresh->second.def;
+    }
+    auto kept = reuse.modules.find(resolved.string());
+    if (kept != reuse.modules.end() && kept->second.name == moduleName && kept->second.def) {
+      return kept->second.def;
+    }
+  }
+
+#ifdef __EMSCRIPTEN__
+  EM_ASM({
+    console.log('📦 ModuleLoader called for:', UTF8ToString($0));
+    console.log('📦 Current dependencies count:', $1);
+  }, resolved.string().c_str(), data ? data->dependencies.size() : 0);
+#endif
+
+  // Check for circular dependency to prevent stack overflow
+  if (data && data->dependencies.find(resolved) != data->dependencies.end()) {
+#ifdef __EMSCRIPTEN__
+    EM_ASM({
+      console.error('⚠️ Circular dependency detected:', UTF8ToString($0));
+    }, resolved.string().c_str());
+#endif
+    JS_ThrowReferenceError(ctx, "Circular dependency detected: module '%s' is already being loaded", resolved.string().c_str());
+    return nullptr;
+  }
+
+  if (data) {
+    data->baseDir = resolved.parent_path();
+    data->dependencies.insert(resolved);
+  }
+  
+#ifdef __EMSCRIPTEN__
+  EM_ASM({
+    console.log('🔨 Compiling module in loader:', UTF8ToString($0));
+  }, moduleName.c_str());
+#endif
+  
+  ModuleReuse::Module record;
+  record.name = moduleName;
+  JSValue funcVal = CompileModuleCached(ctx, data, resolved, record);
+  if (JS_IsException(funcVal)) {
+#ifdef __EMSCRIPTEN__
+    EM_ASM({
+      console.error('❌ Module compilation failed in loader:', UTF8ToString($0));
+    }, moduleName.c_str());
+#endif
+    if (data) {
+      data->dependencies.erase(resolved);
+    }
+    return nullptr;
+  }
+
+  auto *module = static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(funcVal));
+  JS_FreeValue(ctx, funcVal);
+  if (data) {
+    record.def = module;
+    data->reuse.loaded[resolved.string()] = std::move(record);
+  }
+  
+#ifdef __EMSCRIPTEN__
+  EM_ASM({
+    console.log('✅ Module loaded successfully:', UTF8ToString($0));
+  }, moduleName.c_str());
+#endif
+  
+  return module;
+}
+
+std::shared_ptr<manifold::Manifold> ComposePlacements(
+    const std::vector<ScenePlacement> &placements) {
+  std::vector<manifold::Manifold> copies;
+  copies.reserve(placements.size());
+  for (const auto &placement : placements) {
+    copies.push_back(placement.manifold->Transform(placement.transform));
+  }
+  return std::make_shared<manifold::Manifold>(manifold::Manifold::Compose(copies));
+}
+
+LoadResult LoadSceneFromFile(JSRuntime *runtime, ModuleLoaderData &loader,
+                              const std::filesystem::path &path) {
+  LoadResult result;
+  const auto absolutePath = std::filesystem::absolute(path);
+  if (!std::filesystem::exists(absolutePath)) {
+    result.message = "Scene file not found: " + absolutePath.string();
+    return result;
+  }
+  loader.baseDir = absolutePath.parent_path();
+  loader.dependencies.clear();
+  loader.dependencies.insert(absolutePath);
+  auto sourceOpt = ReadTextFile(absolutePath);
+  if (!sourceOpt) {
+    result.message = "Unable to read scene file: " + absolutePath.string();
+    result.dependencies.assign(loader.dependencies.begin(),
+                               loader.dependencies.end());
+    return result;
+  }
+  JS_SetModuleLoaderFunc(runtime, NormalizeModuleName, FilesystemModuleLoader,
+                         &loader);
+  JSContext *ctx = BeginSceneContext(runtime, loader);
+  RegisterBindings(ctx);
+  // Unique per load, so a reused context never hands back an old scene.
+  const std::string scenePath = absolutePath.lexically_normal().string();
+  const std::string sceneName =
+      loader.reuse.freshContext
+          ? absolutePath.string()
+          : scenePath + "#" + std::to_string(loader.reuse.serial);
+  loader.reuse.names[scenePath] = sceneName;
+
+  auto captureException = [&]() {
+    JSValue exc = JS_GetException(ctx);
+    JSValue stack = JS_GetPropertyStr(ctx, exc, "stack");
+    const char *stackStr = JS_ToCString(ctx, JS_IsUndefined(stack) ? exc : stack);
+    result.message = stackStr ? stackStr : "JavaScript error";
+    JS_FreeCString(ctx, stackStr);
+    JS_FreeValue(ctx, stack);
+    JS_FreeValue(ctx, exc);
+  };
+  // Also reports the dependencies, which include modules reused from an
+  // earlier load that the loader never saw, and after a failure clears the
+  // cache counts that SweepGeometryCache would otherwise carry over.
+  auto releaseContext = [&](bool success) {
+    if (!success) ResetGeometryCacheStats(runtime);
+    FinishSceneContext(loader, scenePath, success);
+    result.dependencies.assign(loader.dependencies.begin(),
+                               loader.dependencies.end());
+  };
+
+  JSValue moduleFunc = JS_Eval(ctx, sourceOpt->c_str(), sourceOpt->size(), sceneName.c_str(),
+                               JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY);
+  if (JS_IsException(moduleFunc)) {
+    captureException();
+    releaseContext(false);
+    return result;
+  }
+
+  if (JS_ResolveModule(ctx, moduleFunc) < 0) {
+    captureException();
+    JS_FreeValue(ctx, moduleFunc);
+    releaseContext(false);
+    return result;
+  }
+
+  auto *module = static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(moduleFunc));
+  JSValue evalResult = JS_EvalFunction(ctx, moduleFunc);
+  if (JS_IsException(evalResult)) {
+    captureException();
+    releaseContext(false);
+    return result;
+  }
+  JS_FreeValue(ctx, evalResult);
+
+  JSValue moduleNamespace = JS_GetModuleNamespace(ctx, module);
+  if (JS_IsException(moduleNamespace)) {
+    captureException();
+    releaseContext(false);
+    return result;
+  }
+
+  JSValue sceneVal = JS_GetPropertyStr(ctx, moduleNamespace, "scene");
+  if (JS_IsException(sceneVal)) {
+    JS_FreeValue(ctx, moduleNamespace);
+    captureException();
+    releaseContext(false);
+    return result;
+  }
+  JS_FreeValue(ctx, moduleNamespace);
+
+  if (JS_IsUndefined(sceneVal)) {
+    JS_FreeValue(ctx, sceneVal);
+    releaseContext(false);
+    result.message = "Scene module must export 'scene'";
+    return result;
+  }
+
+  if (JS_IsArray(sceneVal)) {
+    if (!GetScenePlacements(ctx, sceneVal, result.placements)) {
+      JS_FreeValue(ctx, sceneVal);
+      captureException();
+      releaseContext(false);
+      return result;
+    }
+    result.manifold = ComposePlacements(result.placements);
+  } else {
+    auto sceneHandle = GetManifoldHandle(ctx, sceneVal);
+    if (!sceneHandle) {
+      JS_FreeValue(ctx, sceneVal);
+      releaseContext(false);
+      result.message = "Exported 'scene' is not a manifold or an array of placements";
+      return result;
+    }
+    result.manifold = sceneHandle;
+  }
+  result.success = true;
+  const GeometryCacheStats cacheStats = SweepGeometryCache(runtime);
+  result.message = "Loaded " + absolutePath.string() + " (" +
+                   std::to_string(cacheStats.hits) + " cached, " +
+                   std::to_string(cacheStats.misses) + " rebuilt)";
+  JS_FreeValue(ctx, sceneVal);
+  releaseContext(true);
+  return result;
+}
+
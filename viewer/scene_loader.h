@@ -0,0 +1,99 @@
+#pragma once
+
+extern "C" {
+#include "quickjs.h"
+}
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "js_bindings.h"
+
+// Compiled bytecode of one imported module, with the file state it was
+// compiled from.
+struct ModuleBytecode {
+  std::filesystem::file_time_type mtime;
+  uintmax_t size = 0;
+  uint64_t contentHash = 0;
+  bool useCache = false;  // source starts with a "use cache" directive
+  std::vector<uint8_t> bytecode;
+};
+
+// Opt-in reuse of evaluated modules. A module whose source starts with a
+// "use cache" directive keeps its evaluated namespace (and the manifolds it
+// built at import time) across reloads, as long as the file and everything it
+// imports are unchanged. That needs the JSContext to outlive a single load, and
+// because QuickJS cannot unload a module, modules that do get re-evaluated are
+// imported under a fresh "path#N" name. Every module is still compiled under
+// its plain path, so the bytecode cache serves all of them; the loader binds
+// the per-load name to the instance itself.
+struct ModuleReuse {
+  struct Module {
+    std::string name;  // name imports resolve to in `context`
+    JSModuleDef *def = nullptr;  // the instance, owned by `context`
+    std::filesystem::file_time_type mtime;
+    uintmax_t size = 0;
+    bool useCache = false;
+    std::set<std::string> imports;
+  };
+
+  JSContext *context = nullptr;
+  // Instances evaluated by the last successful load, by resolved path.
+  std::unordered_map<std::string, Module> modules;
+  // Modules left behind in `context` by earlier loads; bounds its growth.
+  size_t staleInstances = 0;
+  uint64_t serial = 0;
+  bool freshContext = true;
+
+  // Per load: the name each resolved path maps to, what was newly evaluated,
+  // and the import edges seen by the normaliser.
+  std::unordered_map<std::string, std::string> names;
+  std::unordered_map<std::string, Module> loaded;
+  std::unordered_map<std::string, std::set<std::string>> edges;
+};
+
+struct ModuleLoaderData {
+  std::filesystem::path baseDir;
+  std::set<std::filesystem::path> dependencies;
+  // Survives reloads so unchanged library modules skip parsing/compilation.
+  std::unordered_map<std::string, ModuleBytecode> bytecodeCache;
+  ModuleReuse reuse;
+};
+
+struct LoadResult {
+  bool success = false;
+  // The scene as one manifold. When the scene exports placements this is
+  // their composition, used for export and framing.
+  std::shared_ptr<manifold::Manifold> manifold;
+  std::vector<ScenePlacement> placements;
+  std::string message;
+  std::vector<std::filesystem::path> dependencies;
+};
+
+std::optional<std::string> ReadTextFile(const std::filesystem::path &path);
+
+// Module normaliser and loader for JS_SetModuleLoaderFunc. The opaque pointer
+// is the runtime's ModuleLoaderData.
+char *NormalizeModuleName(JSContext *ctx, const char *baseName, const char *moduleName,
+                          void *opaque);
+JSModuleDef *FilesystemModuleLoader(JSContext *ctx, const char *module_name, void *opaque);
+
+// Composes the placed copies into one manifold, without booleans.
+std::shared_ptr<manifold::Manifold> ComposePlacements(
+    const std::vector<ScenePlacement> &placements);
+
+// Evaluates the scene module at `path` and returns its exported `scene`: a
+// manifold, or an array of {manifold, transform?} placements.
+// Every runtime needs its own ModuleLoaderData; runtimes on different threads
+// can load scenes concurrently.
+LoadResult LoadSceneFromFile(JSRuntime *runtime, ModuleLoaderData &loader,
+                             const std::filesystem::path &path);
+
+// Frees the scene context kept for module reuse; call before JS_FreeRuntime.
+void ReleaseSceneContext(ModuleLoaderData &data);
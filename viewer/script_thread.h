@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#include <process.h>
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// Stack of threads that evaluate scene scripts, and the QuickJS stack limit
+// (its default) they run with. The headroom covers the native frames of
+// Manifold and the bindings below the script's own.
+constexpr size_t kScriptThreadStackSize = size_t{8} << 20;
+constexpr size_t kScriptStackLimit = size_t{1} << 20;
+
+// A joinable thread with a kScriptThreadStackSize stack. std::thread cannot
+// choose its stack, and its default can be as small as 512 KiB (macOS).
+class ScriptThread {
+ public:
+  ScriptThread() = default;
+
+  explicit ScriptThread(std::function<void()> body) {
+    auto task = std::make_unique<std::function<void()>>(std::move(body));
+#ifdef _WIN32
+    handle_ = reinterpret_cast<HANDLE>(_beginthreadex(
+        nullptr, static_cast<unsigned>(kScriptThreadStackSize), &Run, task.get(), 0, nullptr));
+    if (!handle_) throw std::system_error(errno, std::generic_category(), "_beginthreadex");
+#else
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, kScriptThreadStackSize);
+    const int err = pthread_create(&handle_, &attr, &Run, task.get());
+    pthread_attr_destroy(&attr);
+    if (err != 0) throw std::system_error(err, std::generic_category(), "pthread_create");
+#endif
+    task.release();  // owned by the thread now
+    joinable_ = true;
+  }
+
+  ScriptThread(ScriptThread &&other) noexcept { *this = std::move(other); }
+  ScriptThread &operator=(ScriptThread &&other) noexcept {
+    if (this != &other) {
+      join();
+      handle_ = other.handle_;
+      joinable_ = std::exchange(other.joinable_, false);
+    }
+    return *this;
+  }
+  ScriptThread(const ScriptThread &) = delete;
+  ScriptThread &operator=(const ScriptThread &) = delete;
+
+  ~ScriptThread() { join(); }
+
+  bool joinable() const { return joinable_; }
+
+  void join() {
+    if (!joinable_) return;
+#ifdef _WIN32
+    WaitForSingleObject(handle_, INFINITE);
+    CloseHandle(handle_);
+#else
+    pthread_join(handle_, nullptr);
+#endif
+    joinable_ = false;
+  }
+
+ private:
+#ifdef _WIN32
+  static unsigned __stdcall Run(void *arg) {
+#else
+  static void *Run(void *arg) {
+#endif
+    std::unique_ptr<std::function<void()>> task(static_cast<std::function<void()> *>(arg));
+    (*task)();
+    return 0;
+  }
+
+#ifdef _WIN32
+  HANDLE handle_ = nullptr;
+#else
+  pthread_t handle_{};
+#endif
+  bool joinable_ = false;
+};
@@ -0,0 +1,279 @@
+#include "sdf.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+uint64_t MixHash(uint64_t state, uint64_t value) {
+  return state ^ (value + 0x9e3779b97f4a7c15ull + (state << 6) + (state >> 2));
+}
+
+uint64_t HashDouble(double value) {
+  if (value == 0.0) value = 0.0;  // fold -0 into +0
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double Length(double x, double y) { return std::sqrt(x * x + y * y); }
+
+double Length(double x, double y, double z) { return std::sqrt(x * x + y * y + z * z); }
+
+// Polynomial smooth minimum; `k` is the blend radius.
+double SmoothMin(double a, double b, double k) {
+  if (k <= 0.0) return std::min(a, b);
+  const double h = std::clamp(0.5 + 0.5 * (b - a) / k, 0.0, 1.0);
+  return b + (a - b) * h - k * h * (1.0 - h);
+}
+
+double SmoothMax(double a, double b, double k) { return -SmoothMin(-a, -b, k); }
+
+size_t AxisCount(double lo, double hi, double spacing) {
+  return std::max<size_t>(2, static_cast<size_t>(std::ceil((hi - lo) / spacing)) + 1);
+}
+
+}  // namespace
+
+SdfNodePtr MakeSdfNode(SdfOp op, std::vector<double> params,
+                       std::vector<SdfNodePtr> children) {
+  auto node = std::make_shared<SdfNode>();
+  node->op = op;
+  uint64_t hash = MixHash(0x5df5df5df5df5df5ull, static_cast<uint64_t>(op));
+  hash = MixHash(hash, params.size());
+  for (double value : params) hash = MixHash(hash, HashDouble(value));
+  hash = MixHash(hash, children.size());
+  for (const auto &child : children) hash = MixHash(hash, child->hash);
+  node->params = std::move(params);
+  node->children = std::move(children);
+  node->hash = hash;
+  return node;
+}
+
+bool SdfProgram::Compile(const SdfNode &root) {
+  code_.clear();
+  return Emit(root, 0, 0);
+}
+
+void SdfProgram::Push(Code code, const std::vector<double> &params) {
+  Instruction instruction{code, {}};
+  std::copy_n(params.begin(), std::min(params.size(), instruction.params.size()),
+              instruction.params.begin());
+  code_.push_back(instruction);
+}
+
+// Appends code that leaves the node's value on the stack. `pointDepth` and
+// `valueDepth` are the stack heights when the node starts.
+bool SdfProgram::Emit(const SdfNode &node, size_t pointDepth, size_t valueDepth) {
+  if (pointDepth >= kMaxDepth || valueDepth >= kMaxDepth) return false;
+  switch (node.op) {
+    case SdfOp::Sphere:
+      Push(Code::Sphere, node.params);
+      return true;
+    case SdfOp::Box:
+      Push(Code::Box, node.params);
+      return true;
+    case SdfOp::Cylinder:
+      Push(Code::Cylinder, node.params);
+      return true;
+    case SdfOp::Torus:
+      Push(Code::Torus, node.params);
+      return true;
+    case SdfOp::Plane:
+      Push(Code::Plane, node.params);
+      return true;
+    case SdfOp::Gyroid:
+      Push(Code::Gyroid, node.params);
+      return true;
+    case SdfOp::Union:
+    case SdfOp::Intersection:
+    case SdfOp::Difference:
+    case SdfOp::SmoothUnion:
+    case SdfOp::SmoothIntersection:
+    case SdfOp::SmoothDifference: {
+      if (node.children.empty()) return false;
+      Code combine = Code::Min;
+      switch (node.op) {
+        case SdfOp::Intersection: combine = Code::Max; break;
+        case SdfOp::Difference: combine = Code::Subtract; break;
+        case SdfOp::SmoothUnion: combine = Code::SmoothMin; break;
+        case SdfOp::SmoothIntersection: combine = Code::SmoothMax; break;
+        case SdfOp::SmoothDifference: combine = Code::SmoothSubtract; break;
+        default: break;
+      }
+      if (!Emit(*node.children[0], pointDepth, valueDepth)) return false;
+      for (size_t i = 1; i < node.children.size(); ++i) {
+        if (!Emit(*node.children[i], pointDepth, valueDepth + 1)) return false;
+        Push(combine, node.params);
+      }
+      return true;
+    }
+    case SdfOp::Translate:
+    case SdfOp::Rotate:
+    case SdfOp::Scale: {
+      if (node.children.size() != 1) return false;
+      const Code begin = node.op == SdfOp::Translate ? Code::PushTranslate
+                         : node.op == SdfOp::Rotate  ? Code::PushRotate
+                                                     : Code::PushScale;
+      Push(begin, node.params);
+      if (!Emit(*node.children[0], pointDepth + 1, valueDepth)) return false;
+      Push(node.op == SdfOp::Scale ? Code::PopScale : Code::PopPoint, node.params);
+      return true;
+    }
+    case SdfOp::Shell:
+    case SdfOp::Offset:
+      if (node.children.size() != 1) return false;
+      if (!Emit(*node.children[0], pointDepth, valueDepth)) return false;
+      Push(node.op == SdfOp::Shell ? Code::Shell : Code::Offset, node.params);
+      return true;
+  }
+  return false;
+}
+
+double SdfProgram::Evaluate(const manifold::vec3 &p) const {
+  std::array<manifold::vec3, kMaxDepth + 1> points;
+  std::array<double, kMaxDepth + 1> values;
+  size_t pt = 0;
+  size_t top = 0;
+  points[0] = p;
+  for (const Instruction &in : code_) {
+    const manifold::vec3 &q = points[pt];
+    const double *k = in.params.data();
+    switch (in.code) {
+      case Code::Sphere:
+        values[top++] = Length(q.x, q.y, q.z) - k[0];
+        break;
+      case Code::Box: {
+        const double dx = std::abs(q.x) - k[0];
+        const double dy = std::abs(q.y) - k[1];
+        const double dz = std::abs(q.z) - k[2];
+        const double outside =
+            Length(std::max(dx, 0.0), std::max(dy, 0.0), std::max(dz, 0.0));
+        values[top++] = outside + std::min(std::max(dx, std::max(dy, dz)), 0.0);
+        break;
+      }
+      case Code::Cylinder: {
+        const double dr = Length(q.x, q.y) - k[0];
+        const double dz = std::abs(q.z) - k[1];
+        values[top++] = std::min(std::max(dr, dz), 0.0) +
+                        Length(std::max(dr, 0.0), std::max(dz, 0.0));
+        break;
+      }
+      case Code::Torus:
+        values[top++] = Length(Length(q.x, q.y) - k[0], q.z) - k[1];
+        break;
+      case Code::Plane:
+        values[top++] = q.x * k[0] + q.y * k[1] + q.z * k[2] - k[3];
+        break;
+      case Code::Gyroid: {
+        const double x = q.x * k[0];
+        const double y = q.y * k[0];
+        const double z = q.z * k[0];
+        const double g = std::sin(x) * std::cos(y) + std::sin(y) * std::cos(z) +
+                         std::sin(z) * std::cos(x);
+        values[top++] = std::abs(g) / k[0] - k[1];
+        break;
+      }
+      case Code::Min:
+        --top;
+        values[top - 1] = std::min(values[top - 1], values[top]);
+        break;
+      case Code::Max:
+        --top;
+        values[top - 1] = std::max(values[top - 1], values[top]);
+        break;
+      case Code::Subtract:
+        --top;
+        values[top - 1] = std::max(values[top - 1], -values[top]);
+        break;
+      case Code::SmoothMin:
+        --top;
+        values[top - 1] = SmoothMin(values[top - 1], values[top], k[0]);
+        break;
+      case Code::SmoothMax:
+        --top;
+        values[top - 1] = SmoothMax(values[top - 1], values[top], k[0]);
+        break;
+      case Code::SmoothSubtract:
+        --top;
+        values[top - 1] = SmoothMax(values[top - 1], -values[top], k[0]);
+        break;
+      case Code::PushTranslate:
+        points[pt + 1] = manifold::vec3(q.x - k[0], q.y - k[1], q.z - k[2]);
+        ++pt;
+        break;
+      case Code::PushRotate:
+        points[pt + 1] = manifold::vec3(k[0] * q.x + k[1] * q.y + k[2] * q.z,
+                                        k[3] * q.x + k[4] * q.y + k[5] * q.z,
+                                        k[6] * q.x + k[7] * q.y + k[8] * q.z);
+        ++pt;
+        break;
+      case Code::PushScale:
+        points[pt + 1] = manifold::vec3(q.x / k[0], q.y / k[0], q.z / k[0]);
+        ++pt;
+        break;
+      case Code::PopPoint:
+        --pt;
+        break;
+      case Code::PopScale:
+        --pt;
+        values[top - 1] *= k[0];
+        break;
+      case Code::Shell:
+        values[top - 1] = std::abs(values[top - 1]) - k[0];
+        break;
+      case Code::Offset:
+        values[top - 1] -= k[0];
+        break;
+    }
+  }
+  // Nodes use the usual negative-inside distances; LevelSet wants the reverse.
+  return top > 0 ? -values[0] : 0.0;
+}
+
+SdfGrid::SdfGrid(const manifold::Box &bounds, double spacing)
+    : origin_(bounds.min),
+      spacing_(spacing),
+      count_{AxisCount(bounds.min.x, bounds.max.x, spacing),
+             AxisCount(bounds.min.y, bounds.max.y, spacing),
+             AxisCount(bounds.min.z, bounds.max.z, spacing)},
+      values_(count_[0] * count_[1] * count_[2], 0.0f) {}
+
+size_t SdfGrid::CountPoints(const manifold::Box &bounds, double spacing) {
+  return AxisCount(bounds.min.x, bounds.max.x, spacing) *
+         AxisCount(bounds.min.y, bounds.max.y, spacing) *
+         AxisCount(bounds.min.z, bounds.max.z, spacing);
+}
+
+// Points are numbered x fastest, then y, then z.
+manifold::vec3 SdfGrid::Point(size_t index) const {
+  const size_t i = index % count_[0];
+  const size_t j = (index / count_[0]) % count_[1];
+  const size_t k = index / (count_[0] * count_[1]);
+  return manifold::vec3(origin_.x + i * spacing_, origin_.y + j * spacing_,
+                        origin_.z + k * spacing_);
+}
+
+double SdfGrid::Evaluate(const manifold::vec3 &p) const {
+  const double coords[3] = {(p.x - origin_.x) / spacing_, (p.y - origin_.y) / spacing_,
+                            (p.z - origin_.z) / spacing_};
+  size_t cell[3];
+  double t[3];
+  for (int axis = 0; axis < 3; ++axis) {
+    const double c = std::clamp(coords[axis], 0.0, static_cast<double>(count_[axis] - 1));
+    cell[axis] = std::min(static_cast<size_t>(c), count_[axis] - 2);
+    t[axis] = c - static_cast<double>(cell[axis]);
+  }
+  auto at = [&](size_t di, size_t dj, size_t dk) {
+    return static_cast<double>(
+        values_[(cell[0] + di) + count_[0] * ((cell[1] + dj) + count_[1] * (cell[2] + dk))]);
+  };
+  auto lerp = [](double a, double b, double w) { return a + (b - a) * w; };
+  const double x00 = lerp(at(0, 0, 0), at(1, 0, 0), t[0]);
+  const double x10 = lerp(at(0, 1, 0), at(1, 1, 0), t[0]);
+  const double x01 = lerp(at(0, 0, 1), at(1, 0, 1), t[0]);
+  const double x11 = lerp(at(0, 1, 1), at(1, 1, 1), t[0]);
+  return lerp(lerp(x00, x10, t[1]), lerp(x01, x11, t[1]), t[2]);
+}
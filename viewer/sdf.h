@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "manifold/manifold.h"
+
+enum class SdfOp : uint8_t {
+  Sphere,        // radius
+  Box,           // half extents x, y, z
+  Cylinder,      // radius, half height (along z)
+  Torus,         // major radius, minor radius (around z)
+  Plane,         // unit normal x, y, z, offset
+  Gyroid,        // wavenumber, half thickness
+  Union,
+  Intersection,
+  Difference,
+  SmoothUnion,   // blend radius
+  SmoothIntersection,
+  SmoothDifference,
+  Translate,     // offset x, y, z
+  Rotate,        // inverse rotation, 3x3 row-major
+  Scale,         // uniform factor
+  Shell,         // half thickness
+  Offset,        // distance
+};
+
+// Immutable SDF expression node. Subtrees are shared between expressions, and
+// `hash` covers the whole subtree so equal expressions hash equally.
+struct SdfNode {
+  SdfOp op;
+  std::vector<double> params;
+  std::vector<std::shared_ptr<const SdfNode>> children;
+  uint64_t hash = 0;
+};
+
+using SdfNodePtr = std::shared_ptr<const SdfNode>;
+
+SdfNodePtr MakeSdfNode(SdfOp op, std::vector<double> params,
+                       std::vector<SdfNodePtr> children = {});
+
+// An SdfNode tree flattened into postfix code. Evaluate returns positive
+// values inside, as Manifold::LevelSet expects. It is const and does not
+// allocate, so LevelSet can call it from all worker threads.
+class SdfProgram {
+ public:
+  static constexpr size_t kMaxDepth = 64;
+
+  // Returns false if the tree nests deeper than kMaxDepth.
+  bool Compile(const SdfNode &root);
+  double Evaluate(const manifold::vec3 &p) const;
+
+ private:
+  enum class Code : uint8_t {
+    Sphere,
+    Box,
+    Cylinder,
+    Torus,
+    Plane,
+    Gyroid,
+    Min,
+    Max,
+    Subtract,
+    SmoothMin,
+    SmoothMax,
+    SmoothSubtract,
+    PushTranslate,
+    PushRotate,
+    PushScale,
+    PopPoint,
+    PopScale,
+    Shell,
+    Offset,
+  };
+
+  struct Instruction {
+    Code code;
+    std::array<double, 9> params{};
+  };
+
+  bool Emit(const SdfNode &node, size_t pointDepth, size_t valueDepth);
+  void Push(Code code, const std::vector<double> &params = {});
+
+  std::vector<Instruction> code_;
+};
+
+// Samples on a regular lattice over `bounds`, read back by trilinear
+// interpolation. Lets fields that are cheap in bulk but expensive per call
+// (JS batch callbacks) be sampled once and meshed in parallel.
+class SdfGrid {
+ public:
+  SdfGrid(const manifold::Box &bounds, double spacing);
+
+  static size_t CountPoints(const manifold::Box &bounds, double spacing);
+
+  size_t NumPoints() const { return values_.size(); }
+  manifold::vec3 Point(size_t index) const;
+  void Set(size_t index, double value) { values_[index] = static_cast<float>(value); }
+  double Evaluate(const manifold::vec3 &p) const;
+
+ private:
+  manifold::vec3 origin_;
+  double spacing_;
+  std::array<size_t, 3> count_;
+  std::vector<float> values_;
+};